@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/cb/src/actions.cpp" "src/cb/CMakeFiles/cb.dir/src/actions.cpp.o" "gcc" "src/cb/CMakeFiles/cb.dir/src/actions.cpp.o.d"
+  "/root/repo/src/cb/src/clipboard.cpp" "src/cb/CMakeFiles/cb.dir/src/clipboard.cpp.o" "gcc" "src/cb/CMakeFiles/cb.dir/src/clipboard.cpp.o.d"
+  "/root/repo/src/cb/src/daemon.cpp" "src/cb/CMakeFiles/cb.dir/src/daemon.cpp.o" "gcc" "src/cb/CMakeFiles/cb.dir/src/daemon.cpp.o.d"
+  "/root/repo/src/cb/src/messages.cpp" "src/cb/CMakeFiles/cb.dir/src/messages.cpp.o" "gcc" "src/cb/CMakeFiles/cb.dir/src/messages.cpp.o.d"
+  "/root/repo/src/cb/src/themes.cpp" "src/cb/CMakeFiles/cb.dir/src/themes.cpp.o" "gcc" "src/cb/CMakeFiles/cb.dir/src/themes.cpp.o.d"
+  "/root/repo/src/cb/src/x11wl.cpp" "src/cb/CMakeFiles/cb.dir/src/x11wl.cpp.o" "gcc" "src/cb/CMakeFiles/cb.dir/src/x11wl.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/gui/CMakeFiles/gui.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
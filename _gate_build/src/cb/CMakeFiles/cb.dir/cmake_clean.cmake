@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "../../cb"
+  "../../cb.pdb"
+  "CMakeFiles/cb.dir/src/actions.cpp.o"
+  "CMakeFiles/cb.dir/src/actions.cpp.o.d"
+  "CMakeFiles/cb.dir/src/clipboard.cpp.o"
+  "CMakeFiles/cb.dir/src/clipboard.cpp.o.d"
+  "CMakeFiles/cb.dir/src/daemon.cpp.o"
+  "CMakeFiles/cb.dir/src/daemon.cpp.o.d"
+  "CMakeFiles/cb.dir/src/messages.cpp.o"
+  "CMakeFiles/cb.dir/src/messages.cpp.o.d"
+  "CMakeFiles/cb.dir/src/themes.cpp.o"
+  "CMakeFiles/cb.dir/src/themes.cpp.o.d"
+  "CMakeFiles/cb.dir/src/x11wl.cpp.o"
+  "CMakeFiles/cb.dir/src/x11wl.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "../../cbbench"
+  "../../cbbench.pdb"
+  "CMakeFiles/cbbench.dir/src/actions.cpp.o"
+  "CMakeFiles/cbbench.dir/src/actions.cpp.o.d"
+  "CMakeFiles/cbbench.dir/src/bench.cpp.o"
+  "CMakeFiles/cbbench.dir/src/bench.cpp.o.d"
+  "CMakeFiles/cbbench.dir/src/clipboard.cpp.o"
+  "CMakeFiles/cbbench.dir/src/clipboard.cpp.o.d"
+  "CMakeFiles/cbbench.dir/src/daemon.cpp.o"
+  "CMakeFiles/cbbench.dir/src/daemon.cpp.o.d"
+  "CMakeFiles/cbbench.dir/src/messages.cpp.o"
+  "CMakeFiles/cbbench.dir/src/messages.cpp.o.d"
+  "CMakeFiles/cbbench.dir/src/themes.cpp.o"
+  "CMakeFiles/cbbench.dir/src/themes.cpp.o.d"
+  "CMakeFiles/cbbench.dir/src/x11wl.cpp.o"
+  "CMakeFiles/cbbench.dir/src/x11wl.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cbbench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
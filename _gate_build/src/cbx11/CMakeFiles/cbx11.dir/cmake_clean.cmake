@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../libcbx11.pdb"
+  "../../libcbx11.so"
+  "CMakeFiles/cbx11.dir/src/x11.cpp.o"
+  "CMakeFiles/cbx11.dir/src/x11.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cbx11.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
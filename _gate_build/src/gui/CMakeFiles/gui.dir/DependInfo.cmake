@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/gui/src/fork.cpp" "src/gui/CMakeFiles/gui.dir/src/fork.cpp.o" "gcc" "src/gui/CMakeFiles/gui.dir/src/fork.cpp.o.d"
+  "/root/repo/src/gui/src/gui.cpp" "src/gui/CMakeFiles/gui.dir/src/gui.cpp.o" "gcc" "src/gui/CMakeFiles/gui.dir/src/gui.cpp.o.d"
+  "/root/repo/src/gui/src/infermime.cpp" "src/gui/CMakeFiles/gui.dir/src/infermime.cpp.o" "gcc" "src/gui/CMakeFiles/gui.dir/src/infermime.cpp.o.d"
+  "/root/repo/src/gui/src/utils.cpp" "src/gui/CMakeFiles/gui.dir/src/utils.cpp.o" "gcc" "src/gui/CMakeFiles/gui.dir/src/utils.cpp.o.d"
+  "/root/repo/src/gui/src/x11wl/mime.cpp" "src/gui/CMakeFiles/gui.dir/src/x11wl/mime.cpp.o" "gcc" "src/gui/CMakeFiles/gui.dir/src/x11wl/mime.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
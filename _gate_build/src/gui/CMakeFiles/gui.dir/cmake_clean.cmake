@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../libgui.a"
+  "../../libgui.pdb"
+  "CMakeFiles/gui.dir/src/fork.cpp.o"
+  "CMakeFiles/gui.dir/src/fork.cpp.o.d"
+  "CMakeFiles/gui.dir/src/gui.cpp.o"
+  "CMakeFiles/gui.dir/src/gui.cpp.o.d"
+  "CMakeFiles/gui.dir/src/infermime.cpp.o"
+  "CMakeFiles/gui.dir/src/infermime.cpp.o.d"
+  "CMakeFiles/gui.dir/src/utils.cpp.o"
+  "CMakeFiles/gui.dir/src/utils.cpp.o.d"
+  "CMakeFiles/gui.dir/src/x11wl/mime.cpp.o"
+  "CMakeFiles/gui.dir/src/x11wl/mime.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gui.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
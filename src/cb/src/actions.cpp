@@ -26,21 +26,216 @@
 #if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
+#if defined(HAVE_ZLIB)
+#include <zlib.h>
 #endif
 
 namespace PerformAction {
 
+static std::mutex copy_mutex; // guards failedItems and the originals buffer while the copy engine is multi-threaded
+static std::string originals_buffer;
+
+void flushOriginals() {
+    if (originals_buffer.empty()) return;
+    writeToFile(path.metadata.originals, originals_buffer, true);
+    originals_buffer.clear();
+}
+
+// Filename patterns from the command line get compiled once per process, and patterns that
+// are really just plain filenames skip the regex machinery entirely and compare as strings,
+// since std::regex construction is slow enough to dominate small-clipboard operations.
+
+struct CompiledPattern {
+    std::string literal;
+    std::optional<std::regex> regex;
+
+    [[nodiscard]] bool matches(const std::string& name) const { return regex.has_value() ? std::regex_match(name, regex.value()) : name == literal; }
+};
+
+CompiledPattern compilePattern(const std::string& pattern) {
+    if (pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos) return {pattern, std::nullopt};
+    return {pattern, std::regex(pattern)};
+}
+
+const std::vector<CompiledPattern>& itemPatterns() {
+    static std::vector<CompiledPattern> patterns = [] {
+        std::vector<CompiledPattern> compiled;
+        std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(compiled), [](const auto& item) { return compilePattern(item.string()); });
+        return compiled;
+    }();
+    return patterns;
+}
+
+bool matchesAnyPattern(const std::vector<CompiledPattern>& patterns, const std::string& name) {
+    return std::any_of(patterns.begin(), patterns.end(), [&](const auto& pattern) { return pattern.matches(name); });
+}
+
+bool isSafeExtractionPath(const fs::path& base, const fs::path& relative) {
+    // paths coming out of archives and framed streams are untrusted: reject anything
+    // absolute or dot-dot, and refuse to write through a symlink planted by an earlier
+    // record, so no record can ever land outside the extraction root
+    if (relative.is_absolute() || relative.has_root_name()) return false;
+    for (const auto& part : relative)
+        if (part == "..") return false;
+    std::error_code ec;
+    auto root = fs::weakly_canonical(base, ec);
+    if (ec) return false;
+    auto resolved = fs::weakly_canonical(base / relative, ec);
+    if (ec) return false;
+    auto root_native = root.native();
+    auto resolved_native = resolved.native();
+    if (!resolved_native.starts_with(root_native)) return false;
+    return resolved_native.size() == root_native.size() || resolved_native.at(root_native.size()) == fs::path::preferred_separator;
+}
+
+unsigned long copyThreadAmount() {
+    unsigned long threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (auto setting = getenv("CLIPBOARD_THREADS"); setting != nullptr) {
+        try {
+            threads = std::max(1ul, std::stoul(setting));
+        } catch (...) {}
+    }
+    return threads;
+}
+
+#if defined(__linux__)
+bool cloneFile(const fs::path& from, const fs::path& to) {
+    // clone the file's extents instead of copying bytes, which is near-instant and still a
+    // fully independent copy on filesystems that support it (Btrfs, XFS), then fall back to
+    // copy_file_range so the data at least stays in the kernel on everything else
+    int in = open(from.string().data(), O_RDONLY);
+    if (in == -1) return false;
+    struct stat info;
+    if (fstat(in, &info) == -1 || !S_ISREG(info.st_mode)) {
+        close(in);
+        return false;
+    }
+    int out = open(to.string().data(), O_WRONLY | O_CREAT | O_TRUNC, info.st_mode & 07777);
+    if (out == -1) {
+        close(in);
+        return false;
+    }
+    bool copied = ioctl(out, FICLONE, in) == 0;
+    if (!copied) {
+        off_t remaining = info.st_size;
+        while (remaining > 0) {
+            auto bytes = copy_file_range(in, nullptr, out, nullptr, remaining, 0);
+            if (bytes <= 0) break;
+            remaining -= bytes;
+        }
+        copied = remaining == 0;
+    }
+    close(in);
+    close(out);
+    if (!copied) fs::remove(to); // don't leave a half-written file behind for fs::copy to trip over
+    return copied;
+}
+#endif
+
+void copyEntry(const fs::path& from, const fs::path& to) {
+    // a safe copy that prefers reflinks: try to clone regular files and walk directories
+    // cloning each file, degrading to fs::copy whenever cloning isn't possible
+#if defined(__linux__)
+    if (!fs::is_symlink(from) && fs::is_regular_file(from)) {
+        if (cloneFile(from, to)) return;
+    } else if (!fs::is_symlink(from) && fs::is_directory(from)) {
+        fs::create_directories(to);
+        for (const auto& entry : fs::recursive_directory_iterator(from)) {
+            auto target = to / entry.path().lexically_relative(from); // lexical so that symlinked entries don't get resolved to their targets
+            if (!entry.is_symlink() && entry.is_directory())
+                fs::create_directories(target);
+            else if (entry.is_symlink() || !entry.is_regular_file() || !cloneFile(entry.path(), target))
+                fs::copy(entry.path(), target, copying.opts);
+        }
+        return;
+    }
+#endif
+    fs::copy(from, to, copying.opts);
+}
+
+// The opt-in blob store (CLIPBOARD_DEDUPE) keeps one copy of identical file content across
+// clipboards: files get hashed after copying and hard-linked to a content-addressed blob, so
+// loading or re-copying the same large artifacts into several clipboards stores them once.
+
+fs::path blobStoreRoot() {
+    return (path.is_persistent ? global_path.persistent : global_path.temporary) / ".blobs";
+}
+
+void deduplicateFile(const fs::path& target) {
+    try {
+        if (fs::is_symlink(target) || !fs::is_regular_file(target)) return;
+        fs::create_directories(blobStoreRoot());
+        auto blob = blobStoreRoot() / std::to_string(fileContentHash(target));
+        if (fs::exists(blob)) {
+            if (fs::file_size(blob) == fs::file_size(target) && !fs::equivalent(blob, target)) {
+                fs::remove(target);
+                fs::create_hard_link(blob, target);
+            }
+        } else {
+            fs::create_hard_link(target, blob);
+        }
+    } catch (const fs::filesystem_error& e) {} // deduplication is best-effort
+}
+
+void deduplicateItem(const fs::path& target) {
+    if (!getenv("CLIPBOARD_DEDUPE")) return;
+    if (fs::is_directory(target))
+        for (const auto& entry : fs::recursive_directory_iterator(target)) {
+            if (!entry.is_symlink() && entry.is_regular_file()) deduplicateFile(entry.path());
+        }
+    else
+        deduplicateFile(target);
+}
+
+void collectBlobGarbage() {
+    // drop blobs nothing links to anymore so the store doesn't grow without bound
+    if (!getenv("CLIPBOARD_DEDUPE") || !fs::is_directory(blobStoreRoot())) return;
+    for (const auto& entry : fs::directory_iterator(blobStoreRoot()))
+        if (entry.hard_link_count() <= 1) fs::remove(entry.path());
+}
+
 void copyItem(const fs::path& f) {
     auto actuallyCopyItem = [&](const bool use_regular_copy = copying.use_safe_copy) {
         if (fs::is_directory(f)) {
             auto target = f.filename().empty() ? f.parent_path().filename() : f.filename();
+            if (getenv("CLIPBOARD_DEDUPE")) fs::remove_all(path.data / target); // never truncate a shared blob in place
             fs::create_directories(path.data / target);
-            fs::copy(f, path.data / target, copying.opts);
+            copyEntry(f, path.data / target);
+            deduplicateItem(path.data / target);
+        } else if (use_regular_copy) {
+            if (getenv("CLIPBOARD_DEDUPE")) fs::remove(path.data / f.filename());
+            copyEntry(f, path.data / f.filename());
+            deduplicateItem(path.data / f.filename());
         } else {
-            fs::copy(f, path.data / f.filename(), use_regular_copy ? copying.opts : copying.opts | fs::copy_options::create_hard_links);
+            fs::copy(f, path.data / f.filename(), copying.opts | fs::copy_options::create_hard_links);
         }
         incrementSuccessesForItem(f);
-        if (action == Action::Cut) writeToFile(path.metadata.originals, fs::absolute(f).string() + "\n", true);
+        if (action == Action::Cut) {
+            // batch the originals bookkeeping instead of an open/append/close cycle per file,
+            // which turns cutting half a million files into half a million syscall pairs
+            std::lock_guard<std::mutex> lock(copy_mutex);
+            originals_buffer += fs::absolute(f).string() + "\n";
+            if (originals_buffer.size() >= (1 << 20)) {
+                writeToFile(path.metadata.originals, originals_buffer, true);
+                originals_buffer.clear();
+            }
+        }
+    };
+    auto itemFailed = [&](const fs::filesystem_error& e) {
+        std::lock_guard<std::mutex> lock(copy_mutex);
+        copying.failedItems.emplace_back(f.string(), e.code());
     };
     try {
         actuallyCopyItem();
@@ -49,17 +244,43 @@ void copyItem(const fs::path& f) {
             try {
                 actuallyCopyItem(true);
             } catch (const fs::filesystem_error& e) {
-                copying.failedItems.emplace_back(f.string(), e.code());
+                itemFailed(e);
             }
         } else {
-            copying.failedItems.emplace_back(f.string(), e.code());
+            itemFailed(e);
         }
     }
 }
 
 void copy() {
-    for (const auto& f : copying.items)
-        copyItem(f);
+    // spread the items across worker threads, with each worker claiming the next unprocessed
+    // item so that a few huge directories don't leave the other threads sitting idle
+    auto threads = std::min(static_cast<unsigned long>(copying.items.size()), copyThreadAmount());
+    if (threads < 2) {
+        for (const auto& f : copying.items)
+            copyItem(f);
+        flushOriginals();
+        collectBlobGarbage();
+        return;
+    }
+    std::atomic<size_t> next_item {0};
+    std::vector<std::thread> workers;
+    for (unsigned long i = 0; i < threads; i++) {
+        workers.emplace_back([&] {
+            for (size_t item = 0; (item = next_item.fetch_add(1)) < copying.items.size();) {
+                try {
+                    copyItem(copying.items.at(item));
+                } catch (const std::exception& e) { // an exception escaping a worker thread would otherwise terminate the process
+                    std::lock_guard<std::mutex> lock(copy_mutex);
+                    copying.failedItems.emplace_back(copying.items.at(item).string(), std::make_error_code(std::errc::io_error));
+                }
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+    flushOriginals();
+    collectBlobGarbage();
 }
 
 void copyText() {
@@ -72,25 +293,25 @@ void copyText() {
     }
 
     if (action == Action::Cut) writeToFile(path.metadata.originals, path.data.raw.string());
+    appendToHistory(copying.buffer);
     successes.bytes = 0; // temporarily disable the bytes success message
 }
 
 void paste() {
-    std::vector<std::regex> regexes;
-    if (!copying.items.empty()) {
-        std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(regexes), [](const auto& item) { return std::regex(item.string()); });
-    }
+    const auto& patterns = itemPatterns();
 
-    for (const auto& entry : fs::directory_iterator(path.data)) {
-        auto target = fs::current_path() / entry.path().filename();
+    for (const auto& entry : directorySnapshot(path.data)) {
+        auto target = fs::current_path() / entry.filename;
         auto pasteItem = [&](const bool use_regular_copy = copying.use_safe_copy) {
-            if (!(fs::exists(target) && fs::equivalent(entry, target))) {
-                fs::copy(entry, target, use_regular_copy || entry.is_directory() ? copying.opts : copying.opts | fs::copy_options::create_hard_links);
+            if (!(fs::exists(target) && fs::equivalent(entry.path, target))) {
+                if (use_regular_copy || entry.is_directory)
+                    copyEntry(entry.path, target);
+                else
+                    fs::copy(entry.path, target, copying.opts | fs::copy_options::create_hard_links);
             }
             incrementSuccessesForItem(entry);
         };
-        if (!regexes.empty() && !std::any_of(regexes.begin(), regexes.end(), [&](const auto& regex) { return std::regex_match(entry.path().filename().string(), regex); }))
-            continue;
+        if (!patterns.empty() && !matchesAnyPattern(patterns, entry.filename)) continue;
         try {
             if (fs::exists(target)) {
                 using enum CopyPolicy;
@@ -102,7 +323,7 @@ void paste() {
                     break;
                 default:
                     stopIndicator();
-                    copying.policy = userDecision(entry.path().filename().string());
+                    copying.policy = userDecision(entry.filename);
                     startIndicator();
                     if (copying.policy == ReplaceOnce || copying.policy == ReplaceAll) {
                         pasteItem();
@@ -117,35 +338,246 @@ void paste() {
                 try {
                     pasteItem(true);
                 } catch (const fs::filesystem_error& e) {
-                    copying.failedItems.emplace_back(entry.path().filename().string(), e.code());
+                    copying.failedItems.emplace_back(entry.filename, e.code());
                 }
             } else {
-                copying.failedItems.emplace_back(entry.path().filename().string(), e.code());
+                copying.failedItems.emplace_back(entry.filename, e.code());
             }
         }
     }
     removeOldFiles();
 }
 
+// A framed stream carries a whole multi-item clipboard over one pipe losslessly:
+//   CBFRAME 1\n
+//   F <size> <mode> <path>\n<bytes>    a file (mode in octal)
+//   D <path>\n                         a directory
+//   L <size> <path>\n<target>          a symlink
+//   E\n                                the end
+// cb paste --archive sends one, and a piped-in cb recognizes the magic automatically, so
+// cb paste --archive | ssh host cb copy moves item boundaries intact with no tar staging.
+
+constexpr std::string_view frame_magic = "CBFRAME 1\n";
+
+size_t readChunkFromStdin(char* buffer, size_t size) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    auto got = read(fileno(stdin), buffer, size);
+    return got > 0 ? got : 0;
+#else
+    DWORD got = 0;
+    if (ReadFile(GetStdHandle(STD_INPUT_HANDLE), buffer, size, &got, NULL) == 0) return 0;
+    return got;
+#endif
+}
+
+void receiveFramedStream(std::string buffered) {
+    size_t position = frame_magic.size();
+
+    auto refill = [&] {
+        std::array<char, 65536> chunk;
+        auto got = readChunkFromStdin(chunk.data(), chunk.size());
+        if (got > 0) buffered.append(chunk.data(), got);
+        return got > 0;
+    };
+    auto readLine = [&]() -> std::string {
+        size_t end;
+        while ((end = buffered.find('\n', position)) == std::string::npos)
+            if (!refill()) return {};
+        auto line = buffered.substr(position, end - position);
+        position = end + 1;
+        if (position > (1 << 20)) { // don't let the consumed prefix grow without bound
+            buffered.erase(0, position);
+            position = 0;
+        }
+        return line;
+    };
+    auto readContent = [&](size_t size, std::ofstream* sink) {
+        std::string link_target;
+        while (size > 0) {
+            if (position >= buffered.size() && !refill()) break;
+            auto take = std::min(size, buffered.size() - position);
+            if (sink != nullptr)
+                sink->write(buffered.data() + position, take);
+            else
+                link_target.append(buffered.data() + position, take);
+            position += take;
+            size -= take;
+            successes.bytes += take;
+            if (position >= buffered.size()) {
+                buffered.clear();
+                position = 0;
+            }
+        }
+        return link_target;
+    };
+
+    for (std::string line; (line = readLine()) != "E" && !line.empty();) {
+        try {
+            auto type = line.substr(0, 1);
+            if (type == "D") {
+                auto relative = line.substr(2);
+                if (!isSafeExtractionPath(path.data, relative)) {
+                    copying.failedItems.emplace_back(relative, std::make_error_code(std::errc::permission_denied));
+                    continue;
+                }
+                fs::create_directories(path.data / relative);
+                continue;
+            }
+            auto space = line.find(' ', 2);
+            size_t size = std::stoull(line.substr(2, space - 2));
+            std::string relative;
+            unsigned int mode = 0;
+            if (type == "F") {
+                auto mode_end = line.find(' ', space + 1);
+                mode = std::stoul(line.substr(space + 1, mode_end - space - 1), nullptr, 8);
+                relative = line.substr(mode_end + 1);
+            } else {
+                relative = line.substr(space + 1);
+            }
+            auto target = path.data / relative;
+            if (!isSafeExtractionPath(path.data, relative)) {
+                readContent(size, nullptr); // skip the payload so the stream stays in sync
+                copying.failedItems.emplace_back(relative, std::make_error_code(std::errc::permission_denied));
+                continue;
+            }
+            fs::create_directories(target.parent_path());
+            if (type == "L") {
+                auto link_target = readContent(size, nullptr);
+                fs::remove(target);
+                fs::create_symlink(link_target, target);
+            } else {
+                fs::remove(target); // never write through a pre-existing symlink
+                std::ofstream sink(target, std::ios::binary | std::ios::trunc);
+                readContent(size, &sink);
+                sink.close();
+                fs::permissions(target, static_cast<fs::perms>(mode), fs::perm_options::replace);
+            }
+        } catch (const fs::filesystem_error& e) {
+            copying.failedItems.emplace_back(line, e.code());
+        }
+    }
+}
+
 void pipeIn() {
-    copying.buffer = pipedInContent();
-    writeToFile(path.data.raw, copying.buffer);
+    // peek at the first chunk: a framed multi-item stream from another cb announces itself.
+    // reads from a pipe can legally return just a few bytes, so keep reading until there's
+    // enough to tell the two formats apart (or the stream ends first)
+    std::string first(65536, '\0');
+    size_t filled = 0;
+    while (filled < frame_magic.size()) {
+        auto got = readChunkFromStdin(first.data() + filled, first.size() - filled);
+        if (got == 0) break;
+        filled += got;
+    }
+    first.resize(filled);
+    if (first.starts_with(frame_magic)) {
+        receiveFramedStream(std::move(first));
+        return;
+    }
+    successes.bytes += first.size();
+    writeToFile(path.data.raw, first);
+    pipedInContentToFile(path.data.raw, true); // leave copying.buffer empty so later steps read from the file instead of a full in-memory copy
     if (action == Action::Cut) writeToFile(path.metadata.originals, path.data.raw.string());
+    appendFileToHistory(path.data.raw);
+}
+
+#if defined(__linux__)
+bool pipeOutSpliced(const fs::path& f) {
+    // move the file content into the stdout pipe entirely within the kernel, so multi-gigabyte
+    // clipboards don't get copied through userspace buffers first
+    int fd = open(f.string().data(), O_RDONLY);
+    if (fd == -1) return false;
+    fflush(stdout);
+    unsigned long long bytes_spliced = 0;
+    for (ssize_t bytes = 0; (bytes = splice(fd, nullptr, fileno(stdout), nullptr, 1 << 26, SPLICE_F_MORE)) != 0;) {
+        if (bytes == -1) {
+            close(fd);
+            if (errno == EINVAL && bytes_spliced == 0) return false; // stdout isn't a pipe, so use the read/write fallback
+            throw std::runtime_error("splice() failed");
+        }
+        bytes_spliced += bytes;
+        successes.bytes += bytes;
+    }
+    close(fd);
+    return true;
 }
+#endif
 
 void pipeOut() {
-    for (const auto& entry : fs::recursive_directory_iterator(path.data)) {
-        std::string content(fileContents(entry.path()));
+    // coalesce small files into one buffer so thousands of them stream out at pipe bandwidth
+    // instead of one tiny syscall each; per-file flushing is kept only for TTYs
+    constexpr size_t buffer_capacity = 1 << 20;
+    std::string buffer;
+    auto writeOut = [](const char* data, size_t length) {
 #if !defined(_WIN32) && !defined(_WIN64)
-        int len = write(fileno(stdout), content.data(), content.size());
-        if (len < 0) throw std::runtime_error("write() failed");
+        while (length > 0) {
+            auto len = write(fileno(stdout), data, length);
+            if (len < 0) throw std::runtime_error("write() failed");
+            data += len;
+            length -= len;
+        }
 #elif defined(_WIN32) || defined(_WIN64)
         _setmode(_fileno(stdout), _O_BINARY);
-        fwrite(content.data(), sizeof(char), content.size(), stdout);
+        fwrite(data, sizeof(char), length, stdout);
 #endif
-        fflush(stdout);
+    };
+    auto flushBuffer = [&] {
+        if (buffer.empty()) return;
+        writeOut(buffer.data(), buffer.size());
+        buffer.clear();
+    };
+    if (archive_option) {
+        // frame the items so the receiving cb can reconstruct the boundaries losslessly
+        buffer += frame_magic;
+        for (const auto& entry : fs::recursive_directory_iterator(path.data)) {
+            auto relative = entry.path().lexically_relative(path.data).string();
+            if (entry.is_symlink()) {
+                auto link_target = fs::read_symlink(entry.path()).string();
+                buffer += "L " + std::to_string(link_target.size()) + " " + relative + "\n" + link_target;
+            } else if (entry.is_directory()) {
+                buffer += "D " + relative + "\n";
+            } else {
+                char mode[16];
+                snprintf(mode, sizeof(mode), "%o", static_cast<unsigned int>(fs::status(entry.path()).permissions()) & 07777);
+                buffer += "F " + std::to_string(entry.file_size()) + " " + mode + " " + relative + "\n";
+                flushBuffer();
+                std::ifstream in(entry.path(), std::ios::binary);
+                std::array<char, 65536> chunk;
+                while (in) {
+                    in.read(chunk.data(), chunk.size());
+                    if (in.gcount() > 0) {
+                        buffer.append(chunk.data(), in.gcount());
+                        successes.bytes += in.gcount();
+                        if (buffer.size() >= buffer_capacity) flushBuffer();
+                    }
+                }
+            }
+            if (buffer.size() >= buffer_capacity) flushBuffer();
+        }
+        buffer += "E\n";
+        flushBuffer();
+        removeOldFiles();
+        return;
+    }
+
+    for (const auto& entry : fs::recursive_directory_iterator(path.data)) {
+#if defined(__linux__)
+        if (entry.is_regular_file() && entry.file_size() > buffer_capacity) {
+            flushBuffer();
+            if (pipeOutSpliced(entry.path())) continue;
+        }
+#endif
+        std::string content(fileContents(entry.path()));
         successes.bytes += content.size();
+        if (is_tty.out) {
+            writeOut(content.data(), content.size());
+            fflush(stdout);
+            continue;
+        }
+        buffer += content;
+        if (buffer.size() >= buffer_capacity) flushBuffer();
     }
+    flushBuffer();
     removeOldFiles();
 }
 
@@ -164,13 +596,13 @@ void clear() {
             int clipboards_cleared = 0;
             if (decision.substr(0, 1) == "y" || decision.substr(0, 1) == "Y") {
                 for (const auto& entry : fs::directory_iterator(global_path.temporary)) {
-                    bool predicate = Clipboard(entry.path().filename().string()).holdsData();
-                    fs::remove_all(entry);
+                    bool predicate = Clipboard(entry.path().filename().string(), false).holdsData();
+                    if (!deferRemoval(entry.path())) fs::remove_all(entry);
                     if (predicate) clipboards_cleared++;
                 }
                 for (const auto& entry : fs::directory_iterator(global_path.persistent)) {
-                    bool predicate = Clipboard(entry.path().filename().string()).holdsData();
-                    fs::remove_all(entry);
+                    bool predicate = Clipboard(entry.path().filename().string(), false).holdsData();
+                    if (!deferRemoval(entry.path())) fs::remove_all(entry);
                     if (predicate) clipboards_cleared++;
                 }
             }
@@ -183,56 +615,43 @@ void clear() {
 }
 
 void show() {
-    std::vector<std::regex> regexes;
-    if (!copying.items.empty()) {
-        std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(regexes), [](const auto& item) { return std::regex(item.string()); });
-    }
+    const auto& patterns = itemPatterns();
 
     stopIndicator();
 
     if (path.holdsRawData()) {
-        std::string content(fileContents(path.data.raw));
-        std::erase(content, '\n');
+        auto total_bytes = fs::file_size(path.data.raw);
+        std::string content(filePreview(path.data.raw, 250)); // only a sliver is ever shown, so don't drag the whole file in
         printf(clipboard_text_contents_message().data(), std::min(static_cast<size_t>(250), content.size()), clipboard_name.data());
         printf(formatMessage("[bold][info]%s\n[blank]").data(), content.substr(0, 250).data());
-        if (content.size() > 250) {
-            printf(and_more_items_message().data(), content.size() - 250);
+        if (total_bytes > 250) {
+            printf(and_more_items_message().data(), total_bytes - 250);
         }
         return;
     }
 
     printf(clipboard_item_many_contents_message().data(), clipboard_name.data());
 
-    for (const auto& entry : fs::directory_iterator(path.data)) {
-        if (!regexes.empty() && !std::any_of(regexes.begin(), regexes.end(), [&](const auto& regex) { return std::regex_match(entry.path().filename().string(), regex); }))
-            continue;
-        printf(formatMessage("[info]│ [bold][help]%s[blank]\n").data(), entry.path().filename().string().data());
+    for (const auto& entry : directorySnapshot(path.data)) {
+        if (!patterns.empty() && !matchesAnyPattern(patterns, entry.filename)) continue;
+        printf(formatMessage("[info]│ [bold][help]%s[blank]\n").data(), entry.filename.data());
     }
 }
 
 void showFilepaths() {
-    std::vector<std::regex> regexes;
-    if (!copying.items.empty()) {
-        std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(regexes), [](const auto& item) { return std::regex(item.string()); });
-    }
+    const auto& patterns = itemPatterns();
 
-    std::vector<fs::path> paths(fs::directory_iterator(path.data), fs::directory_iterator {});
-    if (!regexes.empty())
+    auto paths = directorySnapshot(path.data);
+    if (!patterns.empty())
         paths.erase(
-                std::remove_if(
-                        paths.begin(),
-                        paths.end(),
-                        [&](const auto& entry) {
-                            return !std::any_of(regexes.begin(), regexes.end(), [&](const auto& regex) { return std::regex_match(entry.filename().string(), regex); });
-                        }
-                ),
+                std::remove_if(paths.begin(), paths.end(), [&](const auto& entry) { return !matchesAnyPattern(patterns, entry.filename); }),
                 paths.end()
         );
 
     for (const auto& entry : paths) {
-        printf("\"%s\"", entry.string().data());
+        printf("\"%s\"", entry.path.string().data());
         incrementSuccessesForItem(entry);
-        if (entry != paths.back()) printf(" ");
+        if (&entry != &paths.back()) printf(" ");
     }
 }
 
@@ -249,9 +668,18 @@ void addFiles() {
     }
     for (const auto& f : copying.items)
         copyItem(f);
+    flushOriginals();
+    collectBlobGarbage();
 }
 
 void addData() {
+    if (journaledAddEnabled()) {
+        // wait-free append: one atomic record into the shared journal, no lock taken
+        std::string content(io_type == IOType::Pipe ? pipedInContent() : copying.items.at(0).string());
+        appendToJournal(content);
+        successes.bytes += content.size();
+        return;
+    }
     if (path.holdsRawData()) {
         std::string content;
         if (io_type == IOType::Pipe)
@@ -275,23 +703,68 @@ void addData() {
 }
 
 void removeRegex() {
-    std::vector<std::regex> regexes;
+    std::vector<CompiledPattern> patterns;
     if (io_type == IOType::Pipe)
-        regexes.emplace_back(pipedInContent());
+        patterns.emplace_back(compilePattern(pipedInContent()));
     else
-        std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(regexes), [](const auto& item) { return std::regex(item.string()); });
+        std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(patterns), [](const auto& item) { return compilePattern(item.string()); });
+
+    // the raw-content branch replaces substrings, so everything needs a real regex there
+    std::vector<std::regex> regexes;
+    std::transform(patterns.begin(), patterns.end(), std::back_inserter(regexes), [](const auto& pattern) {
+        return pattern.regex.has_value() ? pattern.regex.value() : std::regex(pattern.literal);
+    });
 
     if (path.holdsRawData()) {
-        std::string content(fileContents(path.data.raw));
-        size_t oldLength = content.size();
+        size_t removed = 0;
+        constexpr size_t streaming_threshold = 64 << 20;
+        if (fs::file_size(path.data.raw) > streaming_threshold) {
+            // process the file in overlapping windows so memory stays bounded no matter how big
+            // the clipboard is; a match longer than the overlap can't span a window boundary
+            constexpr size_t window_size = 4 << 20;
+            constexpr size_t overlap = 64 << 10;
+            fs::path temp(path.data.raw.string() + ".tmp");
+            {
+                std::ifstream in(path.data.raw, std::ios::binary);
+                std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+                std::string carry;
+                std::string chunk(window_size, '\0');
+                while (true) {
+                    in.read(chunk.data(), window_size);
+                    auto got = static_cast<size_t>(std::max<std::streamsize>(in.gcount(), 0));
+                    if (got == 0 && carry.empty()) break;
+                    std::string window = carry + chunk.substr(0, got);
+                    size_t window_length = window.size();
+                    for (const auto& pattern : regexes)
+                        window = std::regex_replace(window, pattern, "");
+                    removed += window_length - window.size();
+                    if (in && window.size() > overlap) {
+                        out.write(window.data(), window.size() - overlap);
+                        carry = window.substr(window.size() - overlap);
+                    } else {
+                        out.write(window.data(), window.size());
+                        carry.clear();
+                        if (!in) break;
+                    }
+                }
+            }
+            if (removed != 0)
+                fs::rename(temp, path.data.raw);
+            else
+                fs::remove(temp);
+        } else {
+            std::string content(fileContents(path.data.raw));
+            size_t oldLength = content.size();
 
-        for (const auto& pattern : regexes)
-            content = std::regex_replace(content, pattern, "");
-        successes.bytes += oldLength - content.size();
+            for (const auto& pattern : regexes)
+                content = std::regex_replace(content, pattern, "");
+            removed = oldLength - content.size();
 
-        if (oldLength != content.size()) {
-            writeToFile(path.data.raw, content);
-        } else {
+            if (removed != 0) writeToFile(path.data.raw, content);
+        }
+        successes.bytes += removed;
+
+        if (removed == 0) {
             fprintf(stderr,
                     "%s",
                     formatMessage("[error]❌ CB couldn't match your pattern(s) against anything. [blank][help]Try using a different pattern instead or check what's "
@@ -300,14 +773,14 @@ void removeRegex() {
             exit(EXIT_FAILURE);
         }
     } else {
-        for (const auto& entry : fs::directory_iterator(path.data)) {
-            for (const auto& pattern : regexes) {
-                if (std::regex_match(entry.path().filename().string(), pattern)) {
+        for (const auto& entry : directorySnapshot(path.data)) {
+            for (const auto& pattern : patterns) {
+                if (pattern.matches(entry.filename)) {
                     try {
-                        fs::remove_all(entry.path());
-                        incrementSuccessesForItem(entry.path());
+                        incrementSuccessesForItem(entry); // count before the entry is gone
+                        fs::remove_all(entry.path);
                     } catch (const fs::filesystem_error& e) {
-                        copying.failedItems.emplace_back(entry.path().filename().string(), e.code());
+                        copying.failedItems.emplace_back(entry.filename, e.code());
                     }
                 }
             }
@@ -361,18 +834,256 @@ void notePipe() {
     exit(EXIT_SUCCESS);
 }
 
+std::vector<std::pair<size_t, size_t>> historyIndex() {
+    // each index line is a fixed-width "offset length" pair in hex, so any entry can be
+    // located in the log with one seek and no scan
+    std::vector<std::pair<size_t, size_t>> index;
+    if (!fs::exists(path.metadata.history_index)) return index;
+    for (const auto& line : fileLines(path.metadata.history_index)) {
+        try {
+            index.emplace_back(std::stoull(line.substr(0, 16), nullptr, 16), std::stoull(line.substr(17, 16), nullptr, 16));
+        } catch (...) {}
+    }
+    return index;
+}
+
+std::string historyEntry(size_t offset, size_t length) {
+    std::string content(length, '\0');
+    std::ifstream log(path.metadata.history, std::ios::binary);
+    log.seekg(offset);
+    log.read(content.data(), length);
+    return content;
+}
+
+unsigned long historyEntryLimit() {
+    unsigned long limit = constants.default_history_entries;
+    if (auto setting = getenv("CLIPBOARD_HISTORY"); setting != nullptr) {
+        try {
+            limit = std::stoul(setting);
+        } catch (...) {}
+    }
+    return limit;
+}
+
+void makeRoomInHistory(unsigned long limit, unsigned long long incoming) {
+    // compact the log so both the entry count and the total byte budget stay bounded no
+    // matter how big the retained payloads are
+    auto index = historyIndex();
+    auto budget = constants.max_history_bytes > incoming ? constants.max_history_bytes - incoming : 0;
+    size_t keep = 0;
+    unsigned long long kept_bytes = 0;
+    for (auto entry = index.rbegin(); entry != index.rend(); entry++) {
+        if (keep + 1 >= limit) break;
+        if (kept_bytes + entry->second > budget) break;
+        kept_bytes += entry->second;
+        keep++;
+    }
+    if (keep == index.size()) return; // everything already fits
+    std::vector<std::string> kept;
+    for (size_t i = index.size() - keep; i < index.size(); i++)
+        kept.emplace_back(historyEntry(index.at(i).first, index.at(i).second));
+    std::string log;
+    std::string new_index;
+    char line[64];
+    for (const auto& entry : kept) {
+        snprintf(line, sizeof(line), "%016zx %016zx\n", log.size(), entry.size());
+        new_index += line;
+        log += entry;
+    }
+    writeToFile(path.metadata.history, log);
+    writeToFile(path.metadata.history_index, new_index);
+}
+
+void recordHistoryEntry(size_t offset, size_t size) {
+    char line[64];
+    snprintf(line, sizeof(line), "%016zx %016zx\n", offset, size);
+    writeToFile(path.metadata.history_index, std::string(line), true);
+}
+
+void appendToHistory(const std::string& content) {
+    auto limit = historyEntryLimit();
+    if (limit == 0 || content.size() > constants.max_history_entry_bytes) return;
+    makeRoomInHistory(limit, content.size());
+    size_t offset = fs::exists(path.metadata.history) ? fs::file_size(path.metadata.history) : 0;
+    writeToFile(path.metadata.history, content, true);
+    recordHistoryEntry(offset, content.size());
+}
+
+void appendFileToHistory(const fs::path& file) {
+    // stream the file into the log in chunks so a huge piped-in payload never gets
+    // re-materialized in memory, and skip payloads too big to be worth duplicating on disk
+    auto limit = historyEntryLimit();
+    std::error_code ec;
+    auto size = fs::file_size(file, ec);
+    if (limit == 0 || ec || size == 0 || size > constants.max_history_entry_bytes) return;
+    makeRoomInHistory(limit, size);
+    size_t offset = fs::exists(path.metadata.history) ? fs::file_size(path.metadata.history) : 0;
+    {
+        std::ifstream in(file, std::ios::binary);
+        std::ofstream log(path.metadata.history, std::ios::binary | std::ios::app);
+        std::array<char, 65536> chunk;
+        while (in) {
+            in.read(chunk.data(), chunk.size());
+            if (in.gcount() > 0) log.write(chunk.data(), in.gcount());
+        }
+    }
+    recordHistoryEntry(offset, size);
+}
+
+void history() {
+    stopIndicator();
+    auto index = historyIndex();
+    if (copying.items.empty()) {
+        if (index.empty()) {
+            fprintf(stderr, "%s", formatMessage("[info]🔷 There is no history for this clipboard.[blank]\n").data());
+            return;
+        }
+        fprintf(stderr, formatMessage("[info]🔷 Here is the history for clipboard [bold]%s[blank][info], newest first: [blank]\n").data(), clipboard_name.data());
+        for (size_t i = 0; i < index.size(); i++) {
+            const auto& entry = index.at(index.size() - 1 - i);
+            std::string preview(historyEntry(entry.first, std::min<size_t>(entry.second, 80)));
+            std::erase(preview, '\n');
+            printf(formatMessage("[info]│ [bold]%zu[blank][info]: [help]%s[blank][info] (%s)[blank]\n").data(), i, preview.data(), formatBytes(entry.second).data());
+        }
+        return;
+    }
+    size_t which = 0;
+    try {
+        which = std::stoul(copying.items.at(0).string());
+        if (which >= index.size()) throw std::out_of_range("history");
+    } catch (...) {
+        fprintf(stderr,
+                formatMessage("[error]❌ The history entry you chose doesn't exist. [blank][help]Try listing the entries first with [bold]%s history[blank][help].[blank]\n").data(),
+                clipboard_invocation.data());
+        exit(EXIT_FAILURE);
+    }
+    const auto& entry = index.at(index.size() - 1 - which);
+    auto content = historyEntry(entry.first, entry.second);
+    clearData(true);
+    writeToFile(path.data.raw, content);
+    if (output_silent) return;
+    fprintf(stderr, formatMessage("[success]✅ Restored history entry [bold]%zu[blank]\n").data(), which);
+}
+
+void undo() {
+    stopIndicator();
+    auto generations = clearGenerations();
+    if (generations.empty()) {
+        fprintf(stderr, "%s", formatMessage("[error]❌ There is nothing to undo for this clipboard. [blank][help]Only cleared content can be brought back.[blank]\n").data());
+        exit(EXIT_FAILURE);
+    }
+    auto& latest = generations.back();
+    try {
+        if (fs::exists(path.data) && !fs::is_empty(path.data)) {
+            // whatever is in the clipboard now becomes a generation itself, so undoing a
+            // mistaken undo works too; like clearData, the name has to sort after every
+            // existing generation
+            auto generation = fs::path(path) / (std::string(constants.data_directory) + "." + std::to_string(std::time(nullptr)));
+            while (fs::exists(generation) || generation.filename() <= generations.back().filename())
+                generation += "+";
+            fs::rename(path.data, generation);
+        } else {
+            fs::remove_all(path.data);
+        }
+        fs::rename(latest, path.data);
+    } catch (const fs::filesystem_error& e) {
+        copying.failedItems.emplace_back(clipboard_name, e.code());
+        return;
+    }
+    if (output_silent) return;
+    fprintf(stderr, "%s", formatMessage("[success]✅ Restored the last cleared content\n").data());
+}
+
+void search() {
+    stopIndicator();
+    if (copying.items.empty()) {
+        fprintf(stderr, formatMessage("[error]❌ You need to choose something to search for. [blank][help]Try [bold]%s search some_text[blank][help].[blank]\n").data(), clipboard_invocation.data());
+        exit(EXIT_FAILURE);
+    }
+
+    auto needle = copying.items.at(0).string();
+    std::transform(needle.begin(), needle.end(), needle.begin(), [](unsigned char c) { return std::tolower(c); });
+    auto contains = [&](std::string haystack) {
+        std::transform(haystack.begin(), haystack.end(), haystack.begin(), [](unsigned char c) { return std::tolower(c); });
+        return haystack.find(needle) != std::string::npos;
+    };
+
+    size_t hits = 0;
+    for (const auto& cb : clipboardsWithContent()) {
+        Clipboard clipboard(cb.first, false);
+
+        // the manifest summarizes most clipboards in one small file, so the common case never
+        // opens the data directory at all; only big raw content needs the full scan below
+        std::string matched_on;
+        if (clipboard.hasFreshManifest()) {
+            auto lines = clipboard.manifestLines();
+            bool is_raw = !lines.empty() && lines.front() == "raw";
+            for (size_t i = 1; i < lines.size() && matched_on.empty(); i++)
+                if (contains(lines.at(i))) matched_on = lines.at(i);
+            if (matched_on.empty() && is_raw && fs::exists(clipboard.data.raw) && fs::file_size(clipboard.data.raw) > 500) {
+                if (contains(fileContents(clipboard.data.raw))) matched_on = "(content)";
+            }
+        } else if (clipboard.holdsRawData()) {
+            if (contains(fileContents(clipboard.data.raw))) matched_on = "(content)";
+        } else {
+            for (const auto& entry : fs::directory_iterator(clipboard.data))
+                if (contains(entry.path().filename().string())) {
+                    matched_on = entry.path().filename().string();
+                    break;
+                }
+        }
+
+        if (!matched_on.empty()) {
+            printf(formatMessage("[info]│ [bold]%s[blank][info]: [help]%s[blank]\n").data(), clipboard.name().data(), matched_on.data());
+            hits++;
+        }
+    }
+
+    if (hits == 0) {
+        fprintf(stderr, "%s", formatMessage("[info]🔷 Nothing matched your search.[blank]\n").data());
+        return;
+    }
+}
+
 std::vector<std::pair<std::string, bool>> clipboardsWithContent() {
     std::vector<std::pair<std::string, bool>> clipboards;
+    auto holdsData = [](Clipboard&& clipboard) {
+        if (clipboard.hasFreshManifest()) return !clipboard.manifestLines().empty();
+        return clipboard.holdsData();
+    };
+    auto isInternal = [](const fs::directory_entry& entry) {
+        return entry.path().filename().string().starts_with("."); // .trash, .blobs, and friends aren't clipboards
+    };
     for (const auto& entry : fs::directory_iterator(global_path.temporary))
-        if (Clipboard(entry.path().filename().string()).holdsData()) clipboards.emplace_back(entry.path().filename().string(), false);
+        if (!isInternal(entry) && holdsData(Clipboard(entry.path().filename().string(), false))) clipboards.emplace_back(entry.path().filename().string(), false);
     for (const auto& entry : fs::directory_iterator(global_path.persistent))
-        if (Clipboard(entry.path().filename().string()).holdsData()) clipboards.emplace_back(entry.path().filename().string(), true);
+        if (!isInternal(entry) && holdsData(Clipboard(entry.path().filename().string(), false))) clipboards.emplace_back(entry.path().filename().string(), true);
     std::sort(clipboards.begin(), clipboards.end());
     return clipboards;
 }
 
+std::string repeatedGlyph(const std::string_view& glyph, long count) {
+    // signed on purpose: layout math can go negative on tiny (or unknown) terminals
+    std::string result;
+    if (count <= 0) return result;
+    result.reserve(glyph.size() * count);
+    for (long i = 0; i < count; i++)
+        result += glyph;
+    return result;
+}
+
+template <typename... args_t>
+void appendFormat(std::string& frame, const std::string& format, args_t... args) {
+    auto needed = snprintf(nullptr, 0, format.data(), args...);
+    if (needed <= 0) return;
+    auto existing = frame.size();
+    frame.resize(existing + needed + 1);
+    snprintf(frame.data() + existing, needed + 1, format.data(), args...);
+    frame.resize(existing + needed);
+}
+
 void status() {
-    syncWithGUIClipboard(true);
+    syncWithGUIClipboard(clipboard_name == constants.default_clipboard_name); // forcing a sync into a named clipboard would drag GUI content into it
     stopIndicator();
     auto clipboards_with_contents = clipboardsWithContent();
     if (clipboards_with_contents.empty()) {
@@ -385,37 +1096,48 @@ void status() {
             ).first.length();
     TerminalSize available(thisTerminalSize());
 
-    fprintf(stderr, "%s", formatMessage("[info]┍━┫ ").data());
-    fprintf(stderr, "%s", check_clipboard_status_message().data());
-    fprintf(stderr, "%s", formatMessage("[info] ┣").data());
-    int columns = thisTerminalSize().columns - (check_clipboard_status_message.rawLength() + 7);
-    std::string bar;
-    for (int i = 0; i < columns; i++)
-        bar += "━";
-    fprintf(stderr, "%s", bar.data());
-    fprintf(stderr, "%s", formatMessage("┑[blank]\n").data());
-
-    auto displayEndbar = [] {
-        static auto total_cols = thisTerminalSize().columns;
-        fprintf(stderr, "\033[%ldG%s\r", total_cols, formatMessage("[info]│[blank]").data());
+    std::string header(formatMessage("[info]┍━┫ "));
+    header += check_clipboard_status_message();
+    header += formatMessage("[info] ┣");
+    header += repeatedGlyph("━", static_cast<long>(available.columns) - static_cast<long>(check_clipboard_status_message.rawLength() + 7));
+    header += formatMessage("┑[blank]\n");
+    fputs(header.data(), stderr);
+
+    auto displayEndbar = [&] {
+        fprintf(stderr, "\033[%zuG%s\r", available.columns, formatMessage("[info]│[blank]").data());
     };
 
     for (const auto& cb : clipboards_with_contents) {
-        Clipboard clipboard(cb.first);
+        Clipboard clipboard(cb.first, false);
 
         int widthRemaining = available.columns - (clipboard.name().length() + 5 + longestClipboardLength);
         displayEndbar();
         printf(formatMessage("[bold][info]│ %*s%s│ [blank]").data(), longestClipboardLength - clipboard.name().length(), "", clipboard.name().data());
 
-        if (clipboard.holdsRawData()) {
-            std::string content(fileContents(clipboard.data.raw));
-            std::erase(content, '\n');
-            printf(formatMessage("[help]%s[blank]\n").data(), content.substr(0, widthRemaining).data());
+        // render from the cached manifest when it's current, so an up-to-date clipboard costs
+        // one sequential read here instead of a directory walk
+        bool is_raw = false;
+        std::string raw_preview;
+        std::vector<std::string> entries;
+        if (clipboard.hasFreshManifest()) {
+            entries = clipboard.manifestLines();
+            is_raw = !entries.empty() && entries.front() == "raw";
+            if (!entries.empty()) entries.erase(entries.begin());
+            if (is_raw) raw_preview = entries.empty() ? std::string() : entries.front();
+        } else if ((is_raw = clipboard.holdsRawData())) {
+            raw_preview = filePreview(clipboard.data.raw, available.columns); // one terminal row at most gets shown
+        } else {
+            for (const auto& entry : fs::directory_iterator(clipboard.data))
+                entries.emplace_back(entry.path().filename().string());
+        }
+
+        if (is_raw) {
+            printf(formatMessage("[help]%s[blank]\n").data(), raw_preview.substr(0, widthRemaining).data());
             continue;
         }
 
-        for (bool first = true; const auto& entry : fs::directory_iterator(clipboard.data)) {
-            int entryWidth = entry.path().filename().string().length();
+        for (bool first = true; const auto& entry : entries) {
+            int entryWidth = entry.length();
 
             if (widthRemaining <= 0) break;
 
@@ -427,67 +1149,106 @@ void status() {
             }
 
             if (entryWidth <= widthRemaining) {
-                printf(formatMessage("[help]%s[blank]").data(), entry.path().filename().string().data());
+                printf(formatMessage("[help]%s[blank]").data(), entry.data());
                 widthRemaining -= entryWidth;
                 first = false;
             }
         }
         printf("\n");
     }
-    fprintf(stderr, "%s", formatMessage("[info]┕").data());
-    std::string bar2;
-    for (int i = 0; i < longestClipboardLength + 1; i++)
-        bar2 += "━";
-    fprintf(stderr, "%s┷", bar2.data());
-    auto cols = thisTerminalSize().columns - (longestClipboardLength + 2);
-    std::string bar3;
-    for (int i = 0; i < cols - 2; i++)
-        bar3 += "━";
-    fprintf(stderr, "%s", bar3.data());
-    fprintf(stderr, "%s", formatMessage("┙[blank]\n").data());
+    std::string footer(formatMessage("[info]┕"));
+    footer += repeatedGlyph("━", static_cast<long>(longestClipboardLength) + 1);
+    footer += "┷";
+    footer += repeatedGlyph("━", static_cast<long>(available.columns) - static_cast<long>(longestClipboardLength + 2) - 2);
+    footer += formatMessage("┙[blank]\n");
+    fputs(footer.data(), stderr);
+}
+
+std::string jsonEscape(const std::string& content) {
+    // one pass with no regex machinery; control characters get escaped too so the output is
+    // actually parseable no matter what's in the clipboard
+    std::string escaped;
+    escaped.reserve(content.size() + content.size() / 8);
+    for (const char byte : content) {
+        switch (byte) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(byte) < 0x20) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", byte);
+                escaped += buffer;
+            } else {
+                escaped += byte;
+            }
+        }
+    }
+    return escaped;
 }
 
 void statusJSON() {
-    printf("{\n");
+    // compose the whole document in one buffer and write it out in a single call
+    std::string output("{\n");
 
     auto clipboards_with_contents = clipboardsWithContent();
 
     for (const auto& cb : clipboards_with_contents) {
-        Clipboard clipboard(cb.first);
+        Clipboard clipboard(cb.first, false);
 
-        printf("    \"%s\": ", clipboard.name().data());
+        output += "    \"" + jsonEscape(clipboard.name()) + "\": ";
 
         if (clipboard.holdsRawData()) {
-            std::string content(fileContents(clipboard.data.raw));
-            content = std::regex_replace(content, std::regex("\""), "\\\"");
-            printf("\"%s\"", content.data());
+            output += "\"" + jsonEscape(fileContents(clipboard.data.raw)) + "\"";
         } else {
-            printf("[");
-            for (bool first = true; const auto& entry : fs::directory_iterator(clipboard.data)) {
-                if (!first) printf(", ");
-                printf("\"%s\"", entry.path().filename().string().data());
+            std::vector<std::string> entries;
+            if (auto lines = clipboard.manifestLines(); clipboard.hasFreshManifest() && !lines.empty() && lines.front() == "items")
+                entries.assign(lines.begin() + 1, lines.end());
+            else
+                for (const auto& entry : fs::directory_iterator(clipboard.data))
+                    entries.emplace_back(entry.path().filename().string());
+            output += "[";
+            for (bool first = true; const auto& entry : entries) {
+                if (!first) output += ", ";
+                output += "\"" + jsonEscape(entry) + "\"";
                 first = false;
             }
-            printf("]");
+            output += "]";
         }
-        if (cb != clipboards_with_contents.back()) printf(",\n");
+        if (cb != clipboards_with_contents.back()) output += ",\n";
     }
-    printf("\n}\n");
+    output += "\n}\n";
+    fputs(output.data(), stdout);
 }
 
 void info() {
     stopIndicator();
-    fprintf(stderr, "%s", formatMessage("[info]┍━┫ ").data());
-    fprintf(stderr, clipboard_name_message().data(), clipboard_name.data());
-    fprintf(stderr, "%s", formatMessage("[info] ┣").data());
-    int columns = thisTerminalSize().columns - ((clipboard_name_message.rawLength() - 2) + clipboard_name.length() + 7);
-    for (int i = 0; i < columns; i++)
-        fprintf(stderr, "━");
-    fprintf(stderr, "%s", formatMessage("┑[blank]\n").data());
-
-    auto displayEndbar = [] {
-        static auto total_cols = thisTerminalSize().columns;
-        fprintf(stderr, "\033[%ldG%s\r", total_cols, formatMessage("[info]│[blank]").data());
+    // compose the whole frame in one buffer and write it with a single call, so the box
+    // doesn't flicker line by line over a laggy pty
+    TerminalSize term(thisTerminalSize());
+    std::string frame;
+    frame.reserve(4096);
+
+    frame += formatMessage("[info]┍━┫ ");
+    appendFormat(frame, clipboard_name_message(), clipboard_name.data());
+    frame += formatMessage("[info] ┣");
+    frame += repeatedGlyph("━", static_cast<long>(term.columns) - static_cast<long>((clipboard_name_message.rawLength() - 2) + clipboard_name.length() + 7));
+    frame += formatMessage("┑[blank]\n");
+
+    auto displayEndbar = [&] {
+        appendFormat(frame, "\033[%zuG%s\r", term.columns, formatMessage("[info]│[blank]").data());
     };
 
 #if defined(__linux__) || defined(__APPLE__) || defined(__unix__)
@@ -496,134 +1257,136 @@ void info() {
     std::string time(std::ctime(&info.st_ctime));
     std::erase(time, '\n');
     displayEndbar();
-    fprintf(stderr, formatMessage("[info]│ Last changed [help]%s[blank]\n").data(), time.data());
+    appendFormat(frame, formatMessage("[info]│ Last changed [help]%s[blank]\n"), time.data());
 #elif defined(__WIN32__) || defined(__WIN64__)
-    fprintf(stderr, formatMessage("[info]│ Last changed [help]%s[blank]\n").data(), std::format("{}", fs::last_write_time(path)).data());
+    displayEndbar();
+    appendFormat(frame, formatMessage("[info]│ Last changed [help]%s[blank]\n"), std::format("{}", fs::last_write_time(path)).data());
 #endif
     displayEndbar();
-    fprintf(stderr, formatMessage("[info]│ Stored in [help]%s[blank]\n").data(), path.string().data());
+    appendFormat(frame, formatMessage("[info]│ Stored in [help]%s[blank]\n"), path.string().data());
     displayEndbar();
-    fprintf(stderr, formatMessage("[info]│ Persistent? [help]%s[blank]\n").data(), path.is_persistent ? "Yes" : "No");
+    appendFormat(frame, formatMessage("[info]│ Persistent? [help]%s[blank]\n"), path.is_persistent ? "Yes" : "No");
 
     if (path.holdsRawData()) {
         displayEndbar();
-        fprintf(stderr, formatMessage("[info]│ Bytes: [help]%s[blank]\n").data(), formatBytes(fs::file_size(path.data.raw)).data());
+        appendFormat(frame, formatMessage("[info]│ Bytes: [help]%s[blank]\n"), formatBytes(fs::file_size(path.data.raw)).data());
         displayEndbar();
-        fprintf(stderr, formatMessage("[info]│ Content type: [help]%s[blank]\n").data(), inferMIMEType(fileContents(path.data.raw)).value_or("(Unknown)").data());
+        appendFormat(frame, formatMessage("[info]│ Content type: [help]%s[blank]\n"), inferMIMETypeFromFile(path.data.raw).value_or("(Unknown)").data());
     } else {
         size_t files = 0;
         size_t directories = 0;
         for (const auto& entry : fs::directory_iterator(path.data))
             entry.is_directory() ? directories++ : files++;
         displayEndbar();
-        fprintf(stderr, formatMessage("[info]│ Files: [help]%zu[blank]\n").data(), files);
+        appendFormat(frame, formatMessage("[info]│ Files: [help]%zu[blank]\n"), files);
         displayEndbar();
-        fprintf(stderr, formatMessage("[info]│ Directories: [help]%zu[blank]\n").data(), directories);
+        appendFormat(frame, formatMessage("[info]│ Directories: [help]%zu[blank]\n"), directories);
     }
 
     if (!available_mimes.empty()) {
         displayEndbar();
-        fprintf(stderr, "%s", formatMessage("[info]│ Available types from GUI: [help]").data());
+        frame += formatMessage("[info]│ Available types from GUI: [help]");
         for (const auto& mime : available_mimes) {
-            fprintf(stderr, "%s", mime.data());
-            if (mime != available_mimes.back()) fprintf(stderr, ", ");
+            frame += mime;
+            if (mime != available_mimes.back()) frame += ", ";
         }
-        fprintf(stderr, "%s", formatMessage("[blank]\n").data());
+        frame += formatMessage("[blank]\n");
     }
     displayEndbar();
-    fprintf(stderr, formatMessage("[info]│ Content cut? [help]%s[blank]\n").data(), fs::exists(path.metadata.originals) ? "Yes" : "No");
+    appendFormat(frame, formatMessage("[info]│ Content cut? [help]%s[blank]\n"), fs::exists(path.metadata.originals) ? "Yes" : "No");
 
     displayEndbar();
-    fprintf(stderr, formatMessage("[info]│ Locked by another process? [help]%s[blank]\n").data(), path.isLocked() ? "Yes" : "No");
+    appendFormat(frame, formatMessage("[info]│ Locked by another process? [help]%s[blank]\n"), path.isLocked() ? "Yes" : "No");
 
     if (path.isLocked()) {
         displayEndbar();
-        fprintf(stderr, formatMessage("[info]│ Locked by process with pid [help]%s[blank]\n").data(), fileContents(path.metadata.lock).data());
+        appendFormat(frame, formatMessage("[info]│ Locked by process with pid [help]%s[blank]\n"), fileContents(path.metadata.lock).data());
     }
 
     displayEndbar();
     if (fs::exists(path.metadata.notes))
-        fprintf(stderr, formatMessage("[info]│ Note: [help]%s[blank]\n").data(), fileContents(path.metadata.notes).data());
+        appendFormat(frame, formatMessage("[info]│ Note: [help]%s[blank]\n"), fileContents(path.metadata.notes).data());
     else
-        fprintf(stderr, "%s", formatMessage("[info]│ There is no note for this clipboard.[blank]\n").data());
+        frame += formatMessage("[info]│ There is no note for this clipboard.[blank]\n");
 
     displayEndbar();
     if (path.holdsIgnoreRegexes()) {
-        fprintf(stderr, "%s", formatMessage("[info]│ Ignore regexes: [help]").data());
+        frame += formatMessage("[info]│ Ignore regexes: [help]");
         auto regexes = fileLines(path.metadata.ignore);
         for (const auto& regex : regexes) {
-            fprintf(stderr, "%s", regex.data());
-            if (regex != regexes.back()) fprintf(stderr, ", ");
+            frame += regex;
+            if (regex != regexes.back()) frame += ", ";
         }
-        fprintf(stderr, "%s", formatMessage("[blank]\n").data());
+        frame += formatMessage("[blank]\n");
     } else
-        fprintf(stderr, "%s", formatMessage("[info]│ There are no ignore regexes for this clipboard.[blank]\n").data());
+        frame += formatMessage("[info]│ There are no ignore regexes for this clipboard.[blank]\n");
+
+    frame += formatMessage("[info]┕");
+    frame += repeatedGlyph("━", static_cast<long>(term.columns) - 2);
+    frame += formatMessage("┙[blank]\n");
 
-    fprintf(stderr, "%s", formatMessage("[info]┕").data());
-    auto cols = thisTerminalSize().columns;
-    for (int i = 0; i < cols - 2; i++)
-        fprintf(stderr, "━");
-    fprintf(stderr, "%s", formatMessage("┙[blank]\n").data());
+    fputs(frame.data(), stderr);
 }
 
 void infoJSON() {
-    printf("{\n");
+    std::string output("{\n");
 
-    printf("    \"name\": \"%s\",\n", clipboard_name.data());
+    output += "    \"name\": \"" + jsonEscape(clipboard_name) + "\",\n";
 
 #if defined(__linux__) || defined(__APPLE__) || defined(__unix__)
     struct stat info;
     stat(path.string().data(), &info);
     std::string time(std::ctime(&info.st_ctime));
     std::erase(time, '\n');
-    printf("    \"lastChanged\": \"%s\",\n", time.data());
+    output += "    \"lastChanged\": \"" + time + "\",\n";
 #elif defined(__WIN32__) || defined(__WIN64__)
-    printf("    \"lastChanged\": \"%s\",\n", std::format("{}", fs::last_write_time(path)).data());
+    output += "    \"lastChanged\": \"" + std::format("{}", fs::last_write_time(path)) + "\",\n";
 #endif
 
-    printf("    \"path\": \"%s\",\n", path.string().data());
-    printf("    \"isPersistent\": %s,\n", path.is_persistent ? "true" : "false");
+    output += "    \"path\": \"" + jsonEscape(path.string()) + "\",\n";
+    output += std::string("    \"isPersistent\": ") + (path.is_persistent ? "true" : "false") + ",\n";
 
     if (path.holdsRawData()) {
-        printf("    \"bytes\": \"%s\",\n", std::to_string(fs::file_size(path.data.raw)).data());
-        printf("    \"contentType\": \"%s\",\n", inferMIMEType(fileContents(path.data.raw)).value_or("(Unknown)").data());
+        output += "    \"bytes\": \"" + std::to_string(fs::file_size(path.data.raw)) + "\",\n";
+        output += "    \"contentType\": \"" + std::string(inferMIMETypeFromFile(path.data.raw).value_or("(Unknown)")) + "\",\n";
     } else {
         size_t files = 0;
         size_t directories = 0;
         for (const auto& entry : fs::directory_iterator(path.data))
             entry.is_directory() ? directories++ : files++;
-        printf("    \"files\": \"%zu\",\n", files);
-        printf("    \"directories\": \"%zu\",\n", directories);
+        output += "    \"files\": \"" + std::to_string(files) + "\",\n";
+        output += "    \"directories\": \"" + std::to_string(directories) + "\",\n";
     }
 
     if (!available_mimes.empty()) {
-        printf("    \"availableTypes\": [");
+        output += "    \"availableTypes\": [";
         for (const auto& mime : available_mimes)
-            printf("\"%s\"%s", mime.data(), mime != available_mimes.back() ? ", " : "");
-        printf("],\n");
+            output += "\"" + jsonEscape(mime) + "\"" + (mime != available_mimes.back() ? ", " : "");
+        output += "],\n";
     }
 
-    printf("    \"contentCut\": %s,\n", fs::exists(path.metadata.originals) ? "true" : "false");
+    output += std::string("    \"contentCut\": ") + (fs::exists(path.metadata.originals) ? "true" : "false") + ",\n";
 
-    printf("    \"locked\": %s,\n", path.isLocked() ? "true" : "false");
-    if (path.isLocked()) printf("    \"lockedBy\": \"%s\",\n", fileContents(path.metadata.lock).data());
+    output += std::string("    \"locked\": ") + (path.isLocked() ? "true" : "false") + ",\n";
+    if (path.isLocked()) output += "    \"lockedBy\": \"" + jsonEscape(fileContents(path.metadata.lock)) + "\",\n";
 
     if (fs::exists(path.metadata.notes))
-        printf("    \"note\": \"%s\"\n", std::regex_replace(fileContents(path.metadata.notes), std::regex("\""), "\\\"").data());
+        output += "    \"note\": \"" + jsonEscape(fileContents(path.metadata.notes)) + "\",\n";
     else
-        printf("    \"note\": \"\"\n");
+        output += "    \"note\": \"\",\n";
 
     if (path.holdsIgnoreRegexes()) {
-        printf("    \"ignoreRegexes\": [");
+        output += "    \"ignoreRegexes\": [";
         auto regexes = fileLines(path.metadata.ignore);
         for (const auto& regex : regexes)
-            printf("\"%s\"%s", std::regex_replace(regex, std::regex("\""), "\\\"").data(), regex != regexes.back() ? ", " : "");
-        printf("]\n");
+            output += "\"" + jsonEscape(regex) + "\"" + (regex != regexes.back() ? ", " : "");
+        output += "]\n";
     } else {
-        printf("    \"ignoreRegexes\": []\n");
+        output += "    \"ignoreRegexes\": []\n";
     }
 
-    printf("}\n");
+    output += "}\n";
+    fputs(output.data(), stdout);
 }
 
 void load() {
@@ -652,7 +1415,10 @@ void load() {
             for (const auto& entry : fs::directory_iterator(destination.data))
                 fs::remove_all(entry.path());
 
-            fs::copy(path.data, destination.data, fs::copy_options::recursive);
+            // clone-based fan-out: on filesystems with reflinks, loading into many destinations
+            // shares storage and is near-instant (hard links would be unsafe here since raw
+            // data gets rewritten in place)
+            copyEntry(path.data, destination.data);
 
             destination.applyIgnoreRegexes();
 
@@ -698,19 +1464,45 @@ void swap() {
     fs::path swapTargetDestination(destination.data);
     swapTargetDestination.replace_extension("swap");
 
-    try {
-        fs::copy(destination.data, swapTargetSource, fs::copy_options::recursive);
-        fs::copy(path.data, swapTargetDestination, fs::copy_options::recursive);
+    auto swapByCopy = [&] {
+        // the copy dance is only needed when the two clipboards live on different filesystems
+        try {
+            fs::copy(destination.data, swapTargetSource, fs::copy_options::recursive);
+            fs::copy(path.data, swapTargetDestination, fs::copy_options::recursive);
+
+            fs::remove_all(path.data);
+            fs::remove_all(destination.data);
 
-        fs::remove_all(path.data);
-        fs::remove_all(destination.data);
+            fs::rename(swapTargetSource, path.data);
+            fs::rename(swapTargetDestination, destination.data);
+        } catch (const fs::filesystem_error& e) {
+            copying.failedItems.emplace_back(destination_name, e.code());
+        }
+    };
 
-        fs::rename(swapTargetSource, path.data);
-        fs::rename(swapTargetDestination, destination.data);
+    // swapping is logically a metadata operation, so do it with three renames instead of
+    // copying both data directories twice
+    try {
+        fs::rename(path.data, swapTargetSource);
     } catch (const fs::filesystem_error& e) {
         copying.failedItems.emplace_back(destination_name, e.code());
+        stopIndicator();
+        fprintf(stderr, formatMessage("[error]❌ CB couldn't swap clipboard %s with %s[blank]\n").data(), clipboard_name.data(), destination_name.data());
+        return;
+    }
+    try {
+        fs::rename(destination.data, path.data);
+        fs::rename(swapTargetSource, destination.data);
+    } catch (const fs::filesystem_error& e) {
+        fs::rename(swapTargetSource, path.data); // put the source back before trying the slow path
+        swapByCopy();
     }
 
+    // renames keep the directory's old mtime, so the destination's manifest (and hash) would
+    // otherwise pass the freshness check while describing the pre-swap content; the source
+    // side gets refreshed by main like any other write action
+    destination.updateManifest();
+
     stopIndicator();
 
     fprintf(stderr, formatMessage("[success]✅ Swapped clipboard %s with %s[blank]\n").data(), clipboard_name.data(), destination_name.data());
@@ -718,12 +1510,167 @@ void swap() {
     if (destination_name == constants.default_clipboard_name) updateGUIClipboard(true);
 }
 
+#if defined(HAVE_ZLIB)
+// Archives are a single compressed stream of simple records, so a whole backup of all
+// clipboards can be moved around as one sequential file instead of a tree of tiny files:
+//   CBARCHIVE 1\n
+//   D <path>\n                 a directory
+//   F <size> <path>\n<bytes>   a file
+//   L <size> <path>\n<target>  a symlink
+//   E\n                        the end
+
+std::string archiveReadLine(gzFile archive) {
+    std::string line;
+    for (int byte = 0; (byte = gzgetc(archive)) != -1 && byte != '\n';)
+        line += static_cast<char>(byte);
+    return line;
+}
+
+int duplicatedFd(FILE* stream) {
+    // gzclose closes the underlying descriptor, so hand zlib a duplicate of stdin/stdout
+#if defined(_WIN32) || defined(_WIN64)
+    return _dup(_fileno(stream));
+#else
+    return dup(fileno(stream));
+#endif
+}
+
+void exportArchive(const std::vector<std::string>& destinations) {
+    gzFile archive = nullptr;
+    if (!is_tty.out) {
+        fflush(stdout);
+        archive = gzdopen(duplicatedFd(stdout), "wb"); // stream the archive straight down the pipe
+    } else {
+        auto archive_path = fs::current_path() / (std::string(constants.import_export_directory) + ".cb");
+        archive = gzopen(archive_path.string().data(), "wb");
+    }
+    if (archive == nullptr) {
+        stopIndicator();
+        fprintf(stderr, "%s", formatMessage("[error]❌ CB couldn't create the archive file. 💡 [help]Try checking if you have the right permissions or not.[blank]\n").data());
+        exit(EXIT_FAILURE);
+    }
+    gzputs(archive, "CBARCHIVE 1\n");
+    for (const auto& name : destinations) {
+        try {
+            Clipboard clipboard(name);
+            clipboard.getLock();
+            if (clipboard.isUnused()) {
+                clipboard.releaseLock();
+                continue;
+            }
+            for (const auto& entry : fs::recursive_directory_iterator(clipboard)) {
+                auto relative = name / entry.path().lexically_relative(clipboard);
+                if (relative.filename() == constants.lock_name) continue;
+                if (entry.is_symlink()) {
+                    auto target = fs::read_symlink(entry.path()).string();
+                    gzputs(archive, ("L " + std::to_string(target.size()) + " " + relative.string() + "\n").data());
+                    gzwrite(archive, target.data(), target.size());
+                } else if (entry.is_directory()) {
+                    gzputs(archive, ("D " + relative.string() + "\n").data());
+                } else {
+                    gzputs(archive, ("F " + std::to_string(entry.file_size()) + " " + relative.string() + "\n").data());
+                    std::ifstream in(entry.path(), std::ios::binary);
+                    std::array<char, 65536> buffer;
+                    while (in) {
+                        in.read(buffer.data(), buffer.size());
+                        if (in.gcount() > 0) gzwrite(archive, buffer.data(), in.gcount());
+                    }
+                }
+            }
+            clipboard.releaseLock();
+            successes.clipboards++;
+        } catch (const fs::filesystem_error& e) {
+            copying.failedItems.emplace_back(name, e.code());
+        }
+    }
+    gzputs(archive, "E\n");
+    gzclose(archive);
+}
+
+void importArchive(gzFile archive, const std::vector<std::string>& filter) {
+    if (archive == nullptr || archiveReadLine(archive) != "CBARCHIVE 1") {
+        stopIndicator();
+        fprintf(stderr, "%s", formatMessage("[error]❌ The file you're trying to import isn't a CB archive. 💡 [help]Try exporting one first with [bold]cb export --archive[blank][help].[blank]\n").data());
+        exit(EXIT_FAILURE);
+    }
+    std::vector<std::string> imported;
+    for (std::string line; (line = archiveReadLine(archive)) != "E" && !line.empty();) {
+        auto type = line.substr(0, 1);
+        size_t size = 0;
+        std::string relative;
+        if (type == "D") {
+            relative = line.substr(2);
+        } else {
+            auto space = line.find(' ', 2);
+            size = std::stoull(line.substr(2, space - 2));
+            relative = line.substr(space + 1);
+        }
+        auto name = fs::path(relative).begin()->string();
+        if (!filter.empty() && std::find(filter.begin(), filter.end(), name) == filter.end()) {
+            // the record sizes let us skip everything that wasn't asked for without unpacking it
+            if (size > 0) gzseek(archive, size, SEEK_CUR);
+            continue;
+        }
+        auto storage_root = isPersistent(name) || getenv("CLIPBOARD_ALWAYS_PERSIST") ? global_path.persistent : global_path.temporary;
+        if (!isSafeExtractionPath(storage_root, relative)) {
+            // same hostile-archive rules as framed streams: nothing lands outside the storage root
+            if (size > 0) gzseek(archive, size, SEEK_CUR);
+            copying.failedItems.emplace_back(relative, std::make_error_code(std::errc::permission_denied));
+            continue;
+        }
+        auto target = storage_root / relative;
+        if (std::find(imported.begin(), imported.end(), name) == imported.end()) imported.emplace_back(name);
+        try {
+            if (type == "D") {
+                fs::create_directories(target);
+            } else if (type == "L") {
+                std::string link_target(size, '\0');
+                gzread(archive, link_target.data(), size);
+                fs::create_directories(target.parent_path());
+                fs::remove(target);
+                fs::create_symlink(link_target, target);
+            } else {
+                fs::create_directories(target.parent_path());
+                fs::remove(target); // never write through a pre-existing symlink
+                std::ofstream out(target, std::ios::binary | std::ios::trunc);
+                std::array<char, 65536> buffer;
+                for (size_t remaining = size; remaining > 0;) {
+                    auto got = gzread(archive, buffer.data(), std::min(remaining, buffer.size()));
+                    if (got <= 0) break;
+                    out.write(buffer.data(), got);
+                    remaining -= got;
+                }
+            }
+        } catch (const fs::filesystem_error& e) {
+            copying.failedItems.emplace_back(relative, e.code());
+        }
+    }
+    gzclose(archive);
+    successes.clipboards += imported.size();
+}
+#endif
+
 void importClipboards() {
+#if defined(HAVE_ZLIB)
+    if (io_type == IOType::Pipe) {
+        importArchive(gzdopen(duplicatedFd(stdin), "rb"), {}); // archive streamed in over the pipe
+        return;
+    }
+#endif
+
     fs::path importDirectory;
     if (copying.items.empty())
         importDirectory = fs::current_path() / "Exported_Clipboards";
-    else
-        importDirectory = copying.items.at(0);
+    else {
+        // the items get sorted during deduplication, so pick the one that exists on disk as
+        // the source and keep the rest as clipboard names to select
+        for (const auto& item : copying.items)
+            if (fs::exists(item)) {
+                importDirectory = item;
+                break;
+            }
+        if (importDirectory.empty()) importDirectory = copying.items.at(0);
+    }
 
     if (!fs::exists(importDirectory)) {
         stopIndicator();
@@ -731,6 +1678,17 @@ void importClipboards() {
         exit(EXIT_FAILURE);
     }
 
+#if defined(HAVE_ZLIB)
+    if (fs::is_regular_file(importDirectory)) {
+        // any other items select just those clipboards out of the archive
+        std::vector<std::string> filter;
+        for (const auto& item : copying.items)
+            if (item != importDirectory) filter.emplace_back(item.string());
+        importArchive(gzopen(importDirectory.string().data(), "rb"), filter);
+        return;
+    }
+#endif
+
     if (!fs::is_directory(importDirectory)) {
         stopIndicator();
         fprintf(stderr, "%s", formatMessage("[error]❌ The directory you're trying to import from isn't a directory. 💡 [help]Try choosing a different one instead.[blank]\n").data()
@@ -738,40 +1696,59 @@ void importClipboards() {
         exit(EXIT_FAILURE);
     }
 
+    std::vector<std::pair<std::string, fs::path>> imports; // name, source path
+    std::string conflicts;
     for (const auto& entry : fs::directory_iterator(importDirectory)) {
-        if (!entry.is_directory())
+        if (!entry.is_directory()) {
             copying.failedItems.emplace_back(entry.path().filename().string(), std::make_error_code(std::errc::not_a_directory));
-        else {
-            try {
-                auto target = (isPersistent(entry.path().filename().string()) || getenv("CLIPBOARD_ALWAYS_PERSIST") ? global_path.persistent : global_path.temporary)
-                              / entry.path().filename();
-                if (fs::exists(target)) {
-                    using enum CopyPolicy;
-                    switch (copying.policy) {
-                    case SkipAll:
-                        continue;
-                    case ReplaceAll:
-                        fs::copy(entry.path(), target, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
-                        successes.clipboards++;
-                        break;
-                    default:
-                        stopIndicator();
-                        copying.policy = userDecision(entry.path().filename().string());
-                        startIndicator();
-                        if (copying.policy == ReplaceOnce || copying.policy == ReplaceAll) {
-                            fs::copy(entry.path(), target, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
-                            successes.clipboards++;
-                        }
-                        break;
-                    }
-                } else {
-                    fs::copy(entry.path(), target, fs::copy_options::recursive);
-                    successes.clipboards++;
-                }
-            } catch (const fs::filesystem_error& e) {
-                copying.failedItems.emplace_back(entry.path().filename().string(), e.code());
-            }
+            continue;
         }
+        auto name = entry.path().filename().string();
+        auto target = (isPersistent(name) || getenv("CLIPBOARD_ALWAYS_PERSIST") ? global_path.persistent : global_path.temporary) / name;
+        if (fs::exists(target)) conflicts += conflicts.empty() ? name : ", " + name;
+        imports.emplace_back(name, entry.path());
+    }
+
+    // resolve every conflict with one upfront prompt instead of stalling the transfer on an
+    // interactive question partway through
+    if (!conflicts.empty() && copying.policy == CopyPolicy::Unknown) {
+        stopIndicator();
+        copying.policy = userDecision(conflicts);
+        startIndicator();
+    }
+
+    auto importClipboard = [&](const std::string& name, const fs::path& source) {
+        using enum CopyPolicy;
+        try {
+            auto target = (isPersistent(name) || getenv("CLIPBOARD_ALWAYS_PERSIST") ? global_path.persistent : global_path.temporary) / name;
+            if (fs::exists(target) && copying.policy != ReplaceOnce && copying.policy != ReplaceAll) return;
+            Clipboard destination(name);
+            destination.getLock(); // per-destination locks, so parallel imports don't trample live clipboards
+            fs::copy(source, target, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+            destination.releaseLock();
+            std::lock_guard<std::mutex> lock(copy_mutex);
+            successes.clipboards++;
+        } catch (const fs::filesystem_error& e) {
+            std::lock_guard<std::mutex> lock(copy_mutex);
+            copying.failedItems.emplace_back(name, e.code());
+        }
+    };
+
+    auto threads = std::min(static_cast<unsigned long>(imports.size()), copyThreadAmount());
+    if (threads < 2) {
+        for (const auto& entry : imports)
+            importClipboard(entry.first, entry.second);
+    } else {
+        std::atomic<size_t> next_import {0};
+        std::vector<std::thread> workers;
+        for (unsigned long i = 0; i < threads; i++) {
+            workers.emplace_back([&] {
+                for (size_t entry = 0; (entry = next_import.fetch_add(1)) < imports.size();)
+                    importClipboard(imports.at(entry).first, imports.at(entry).second);
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
     }
 }
 
@@ -781,16 +1758,32 @@ void exportClipboards() {
         std::transform(copying.items.begin(), copying.items.end(), std::back_inserter(destinations), [](const auto& item) { return item.string(); });
     else {
         for (const auto& entry : fs::directory_iterator(global_path.temporary))
-            destinations.emplace_back(entry.path().filename().string());
+            if (!entry.path().filename().string().starts_with(".")) destinations.emplace_back(entry.path().filename().string());
         for (const auto& entry : fs::directory_iterator(global_path.persistent))
-            destinations.emplace_back(entry.path().filename().string());
+            if (!entry.path().filename().string().starts_with(".")) destinations.emplace_back(entry.path().filename().string()); // skip .trash/.blobs, which aren't clipboards
+    }
+
+    if (archive_option || !is_tty.out) { // a piped export always streams an archive, so cb export | ssh host cb import just works
+#if defined(HAVE_ZLIB)
+        exportArchive(destinations);
+        if (successes.clipboards == 0) {
+            stopIndicator();
+            printf("%s", no_clipboard_contents_message().data());
+            printf(clipboard_action_prompt().data(), clipboard_invocation.data(), clipboard_invocation.data());
+            exit(EXIT_FAILURE);
+        }
+        return;
+#else
+        stopIndicator();
+        fprintf(stderr, "%s", formatMessage("[error]❌ This build of CB doesn't support compressed archives.[blank]\n").data());
+        exit(EXIT_FAILURE);
+#endif
     }
 
     fs::path exportDirectory(fs::current_path() / "Exported_Clipboards");
 
     try {
-        if (fs::exists(exportDirectory)) fs::remove_all(exportDirectory);
-        fs::create_directory(exportDirectory);
+        fs::create_directory(exportDirectory); // keep any previous export around so unchanged clipboards don't get rewritten
     } catch (const fs::filesystem_error& e) {
         stopIndicator();
         fprintf(stderr, "%s", formatMessage("[error]❌ CB couldn't create the export directory. 💡 [help]Try checking if you have the right permissions or not.[blank]\n").data());
@@ -801,18 +1794,62 @@ void exportClipboards() {
         try {
             Clipboard clipboard(name);
             clipboard.getLock();
-            if (clipboard.isUnused()) return;
-            fs::copy(clipboard, exportDirectory / name, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
-            fs::remove(exportDirectory / name / constants.metadata_directory / constants.lock_name);
+            if (clipboard.isUnused()) {
+                clipboard.releaseLock();
+                return;
+            }
+            auto target = exportDirectory / name;
+            // incremental: only rewrite files whose size or mtime differ from the existing
+            // export, and drop exported files the clipboard no longer has
+            for (const auto& entry : fs::recursive_directory_iterator(clipboard)) {
+                auto destination = target / entry.path().lexically_relative(clipboard);
+                if (destination.filename() == constants.lock_name) continue;
+                if (!entry.is_symlink() && entry.is_directory()) {
+                    fs::create_directories(destination);
+                } else if (!entry.is_symlink() && entry.is_regular_file()) {
+                    if (fs::exists(destination) && fs::file_size(destination) == entry.file_size() && fs::last_write_time(destination) >= entry.last_write_time()) continue;
+                    fs::create_directories(destination.parent_path());
+                    fs::copy(entry.path(), destination, fs::copy_options::overwrite_existing);
+                } else {
+                    fs::remove(destination);
+                    fs::copy(entry.path(), destination, fs::copy_options::copy_symlinks);
+                }
+            }
+            if (fs::exists(target)) {
+                std::vector<fs::path> stale; // collected first since removing while iterating invalidates the walk
+                for (const auto& entry : fs::recursive_directory_iterator(target)) {
+                    fs::path source = clipboard / entry.path().lexically_relative(target);
+                    if (!fs::exists(source) || entry.path().filename() == constants.lock_name) stale.emplace_back(entry.path());
+                }
+                for (const auto& entry : stale)
+                    fs::remove_all(entry);
+            }
             clipboard.releaseLock();
+            std::lock_guard<std::mutex> lock(copy_mutex);
             successes.clipboards++;
         } catch (const fs::filesystem_error& e) {
+            std::lock_guard<std::mutex> lock(copy_mutex);
             copying.failedItems.emplace_back(name, e.code());
         }
     };
 
-    for (const auto& name : destinations)
-        exportClipboard(name);
+    // export the clipboards across worker threads since each one is independent
+    auto threads = std::min(static_cast<unsigned long>(destinations.size()), copyThreadAmount());
+    if (threads < 2) {
+        for (const auto& name : destinations)
+            exportClipboard(name);
+    } else {
+        std::atomic<size_t> next_destination {0};
+        std::vector<std::thread> workers;
+        for (unsigned long i = 0; i < threads; i++) {
+            workers.emplace_back([&] {
+                for (size_t destination = 0; (destination = next_destination.fetch_add(1)) < destinations.size();)
+                    exportClipboard(destinations.at(destination));
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
 
     if (destinations.empty() || successes.clipboards == 0) {
         stopIndicator();
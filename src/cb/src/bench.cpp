@@ -0,0 +1,149 @@
+/*  The Clipboard Project - Cut, copy, and paste anything, anywhere, all from the terminal.
+    Copyright (C) 2023 Jackson Huff and other contributors on GitHub.com
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.*/
+#include "clipboard.hpp"
+#include <chrono>
+#include <fstream>
+
+// Microbenchmarks over cb's hot paths, so throughput changes show up as numbers instead of
+// anecdotes. Build with `cmake --build . --target cbbench` and run the binary directly.
+// CLIPBOARD_BENCH_FILES scales the generated tree (default 10000 small files).
+
+using clock_type = std::chrono::steady_clock;
+
+// every allocation in the process funnels through here so the benchmarks can report
+// allocations per operation and catch allocation regressions in CI
+static std::atomic<unsigned long long> allocation_count {0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+static fs::path bench_root;
+
+template <typename func_t>
+void benchAllocations(const std::string& name, func_t&& func) {
+    func(); // warm up any one-time setup
+    auto before = allocation_count.load();
+    func();
+    printf("%-28s %12llu allocations/op\n", name.data(), allocation_count.load() - before);
+}
+
+template <typename func_t>
+void bench(const std::string& name, unsigned long long bytes_per_op, func_t&& func) {
+    func(); // warm up caches and page in the fixture
+    size_t iterations = 0;
+    auto start = clock_type::now();
+    std::chrono::nanoseconds elapsed {0};
+    do {
+        func();
+        iterations++;
+        elapsed = clock_type::now() - start;
+    } while (elapsed < std::chrono::milliseconds(500));
+    auto nanoseconds_per_op = elapsed.count() / iterations;
+    printf("%-28s %12ld ns/op", name.data(), nanoseconds_per_op);
+    if (bytes_per_op > 0) printf(" %10s/s", formatBytes(bytes_per_op * 1e9 / nanoseconds_per_op).data());
+    printf("  (%zu runs)\n", iterations);
+}
+
+void generateTree(const fs::path& root, size_t files) {
+    fs::create_directories(root);
+    for (size_t i = 0; i < files; i++) {
+        std::ofstream file(root / ("file" + std::to_string(i)));
+        file << "some small file content " << i << "\n";
+    }
+}
+
+int main() {
+    bench_root = fs::temp_directory_path() / "cbbench";
+    fs::remove_all(bench_root);
+    fs::create_directories(bench_root);
+
+    global_path.temporary = bench_root / constants.temporary_directory_name;
+    global_path.persistent = bench_root / constants.persistent_directory_name;
+    fs::create_directories(global_path.temporary);
+    fs::create_directories(global_path.persistent);
+    path = Clipboard("0");
+    progress_silent = true;
+    output_silent = true;
+    is_tty = {false, false, false};
+
+    size_t tree_files = 10000;
+    if (auto setting = getenv("CLIPBOARD_BENCH_FILES"); setting != nullptr) tree_files = std::stoul(setting);
+
+    printf("The Clipboard Project benchmarks (%zu-file tree fixture)\n\n", tree_files);
+
+    // file I/O primitives
+    std::string megabyte(1 << 20, 'x');
+    auto scratch = bench_root / "scratch";
+    bench("writeToFile 1MB", 1 << 20, [&] { writeToFile(scratch, megabyte); });
+    bench("fileContents 1MB", 1 << 20, [&] { fileContents(scratch); });
+    bench("readPrefix 4KB of 1MB", 4096, [&] { readPrefix(scratch, 4096); });
+
+    // message formatting
+    bench("formatMessage", 0, [] { formatMessage("[error]❌ Some error happened. [blank][help]Try something else with [bold]cb copy[blank][help] instead.[blank]\n"); });
+    bench("Message::rawLength", 0, [] { clipboard_text_contents_message.rawLength(); });
+    bench("formatBytes", 0, [] { formatBytes(123456789.0); });
+
+    // MIME inference over typical payloads
+    std::string png_payload = std::string("\x89PNG\r\n\x1a\n", 8) + std::string(4096, '\0');
+    bench("inferMIMEType png", 0, [&] { inferMIMEType(png_payload); });
+    bench("inferMIMEType text", 0, [&] { inferMIMEType(megabyte); });
+
+    // copy engine over a generated tree
+    auto tree = bench_root / "tree";
+    generateTree(tree, tree_files);
+    action = Action::Copy;
+    io_type = IOType::File;
+    copying.items.assign({tree});
+    bench("copy small-file tree", 0, [&] {
+        for (const auto& entry : fs::directory_iterator(path.data))
+            fs::remove_all(entry.path());
+        PerformAction::copy();
+    });
+
+    auto big_file = bench_root / "big.bin";
+    writeToFile(big_file, std::string(64 << 20, 'b'));
+    copying.items.assign({big_file});
+    bench("copy single 64MB file", 64 << 20, [&] {
+        for (const auto& entry : fs::directory_iterator(path.data))
+            fs::remove_all(entry.path());
+        PerformAction::copy();
+    });
+
+    // allocation profiles over the standard operations
+    printf("\n");
+    benchAllocations("alloc: formatMessage", [] { formatMessage("[info]Some [bold]formatted[blank][info] message[blank]"); });
+    benchAllocations("alloc: fileContents 1MB", [&] { fileContents(scratch); });
+    copying.items.assign({bench_root / "tree" / "file0"});
+    benchAllocations("alloc: copy one file", [&] { PerformAction::copy(); });
+    for (int i = 0; i < 50; i++) {
+        Clipboard clipboard(std::to_string(i));
+        writeToFile(clipboard.data.raw, "clipboard " + std::to_string(i));
+        clipboard.updateManifest();
+    }
+    benchAllocations("alloc: status over 50", [] { PerformAction::clipboardsWithContent(); });
+
+    fs::remove_all(bench_root);
+}
@@ -20,12 +20,15 @@
 #include <clipboard/fork.hpp>
 #include <condition_variable>
 #include <csignal>
+#include <ctime>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <locale>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <regex>
@@ -46,14 +49,23 @@
 #endif
 
 #if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#include <cerrno>
+#endif
+
 namespace fs = std::filesystem;
 
 Forker forker {};
 
+std::pmr::monotonic_buffer_resource arena;
+
 GlobalFilepaths global_path;
 Clipboard path;
 Copying copying;
@@ -64,6 +76,8 @@ bool confirmation_silent = false;
 bool no_color = false;
 bool no_emoji = false;
 bool all_option = false;
+bool archive_option = false;
+bool sync_option = false;
 
 std::string preferred_mime;
 std::vector<std::string> available_mimes;
@@ -101,6 +115,35 @@ std::array<std::pair<std::string_view, std::string_view>, 7> colors = {
 UINT old_code_page;
 #endif
 
+// Scoped phase timing behind CLIPBOARD_PROFILE: near-zero cost when disabled, and a
+// breakdown on stderr at exit when enabled, so slow invocations can say where the time went.
+static std::vector<std::pair<std::string_view, std::chrono::nanoseconds>> profile_spans;
+static bool profiling_enabled = false;
+
+class ProfileSpan {
+    std::string_view name;
+    std::chrono::steady_clock::time_point begin;
+
+public:
+    ProfileSpan(const std::string_view& name) : name(name) {
+        if (profiling_enabled) begin = std::chrono::steady_clock::now();
+    }
+    ~ProfileSpan() {
+        if (profiling_enabled) profile_spans.emplace_back(name, std::chrono::steady_clock::now() - begin);
+    }
+};
+
+void printProfile() {
+    if (!profiling_enabled) return;
+    std::chrono::nanoseconds total {0};
+    for (const auto& span : profile_spans)
+        total += span.second;
+    fprintf(stderr, "%s", formatMessage("[info]┃ Timing breakdown[blank]\n").data());
+    for (const auto& span : profile_spans)
+        fprintf(stderr, formatMessage("[info]┃ %-12s [help]%10.3fms[blank]\n").data(), span.first.data(), span.second.count() / 1e6);
+    fprintf(stderr, formatMessage("[info]┃ %-12s [bold]%10.3fms[blank]\n").data(), "total", total.count() / 1e6);
+}
+
 bool stopIndicator(bool change_condition_variable) {
     ProgressState expect = ProgressState::Active;
 
@@ -127,17 +170,116 @@ TerminalSize thisTerminalSize() {
 }
 
 std::string fileContents(const fs::path& path) {
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    // map the file in and copy it out in one go, skipping the stringstream's repeated
+    // reallocations and double buffering
+    if (int fd = open(path.string().data(), O_RDONLY); fd != -1) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            if (info.st_size == 0) {
+                close(fd);
+                return {};
+            }
+            if (auto map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0); map != MAP_FAILED) {
+                close(fd);
+                std::string content(static_cast<char*>(map), info.st_size);
+                munmap(map, info.st_size);
+                return content;
+            }
+        }
+        close(fd);
+    }
+#endif
     std::stringstream buffer;
     buffer << std::ifstream(path, std::ios::binary).rdbuf();
     return buffer.str();
 }
 
+unsigned long long contentHash(const std::string& content) {
+    // FNV-1a, shared by every place that fingerprints clipboard content
+    unsigned long long hash = 14695981039346656037ull;
+    for (const char byte : content)
+        hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ull;
+    return hash;
+}
+
+unsigned long long fileContentHash(const fs::path& path) {
+    // same as contentHash, but streamed so big files don't get loaded whole
+    unsigned long long hash = 14695981039346656037ull;
+    std::ifstream in(path, std::ios::binary);
+    std::array<char, 65536> buffer;
+    while (in) {
+        in.read(buffer.data(), buffer.size());
+        for (std::streamsize i = 0; i < in.gcount(); i++)
+            hash = (hash ^ static_cast<unsigned char>(buffer.at(i))) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::map<std::string, std::vector<SnapshotEntry>> directory_snapshots;
+static std::mutex directory_snapshots_mutex; // the indicator thread takes snapshots too
+
+const std::vector<SnapshotEntry>& directorySnapshot(const fs::path& directory) {
+    std::lock_guard<std::mutex> lock(directory_snapshots_mutex);
+    auto key = directory.string();
+    if (auto cached = directory_snapshots.find(key); cached != directory_snapshots.end()) return cached->second;
+    auto& entries = directory_snapshots[key];
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(directory, ec))
+        entries.push_back({entry.path(), entry.path().filename().string(), entry.is_directory()});
+    return entries;
+}
+
+void invalidateDirectorySnapshot(const fs::path& directory) {
+    std::lock_guard<std::mutex> lock(directory_snapshots_mutex);
+    directory_snapshots.erase(directory.string());
+}
+
+std::string readPrefix(const fs::path& path, size_t length) {
+    // read just the first chunk of a file, for previews and MIME sniffing where loading
+    // the whole thing would touch gigabytes to use kilobytes
+    std::string content(length, '\0');
+    std::ifstream file(path, std::ios::binary);
+    file.read(content.data(), length);
+    content.resize(file.gcount() > 0 ? file.gcount() : 0);
+    return content;
+}
+
+std::string filePreview(const fs::path& path, size_t length) {
+    // gather a newline-free preview by reading small windows until enough characters have
+    // been collected, so previewing never materializes the whole file no matter how
+    // newline-dense the content is
+    std::string preview;
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, 4096> window;
+    while (preview.size() < length && file) {
+        file.read(window.data(), window.size());
+        // copy newline-free segments wholesale, letting memchr do the scanning
+        auto remaining = static_cast<size_t>(std::max<std::streamsize>(file.gcount(), 0));
+        for (const char* segment = window.data(); remaining > 0 && preview.size() < length;) {
+            auto newline = static_cast<const char*>(memchr(segment, '\n', remaining));
+            auto take = newline != nullptr ? static_cast<size_t>(newline - segment) : remaining;
+            preview.append(segment, std::min(take, length - preview.size()));
+            if (newline == nullptr) break;
+            remaining -= take + 1;
+            segment = newline + 1;
+        }
+    }
+    return preview;
+}
+
 std::vector<std::string> fileLines(const fs::path& path) {
+    // one read and an in-place split with a capacity hint, instead of a getline loop that
+    // reallocates the vector and a string per line; metadata files are small, so this runs
+    // on nearly every invocation
     std::vector<std::string> lines;
-    std::ifstream input_file(path, std::ios::binary);
-    for (std::string line; !input_file.eof();) {
-        std::getline(input_file, line);
-        if (!line.empty()) lines.emplace_back(line);
+    auto content = fileContents(path);
+    lines.reserve(std::count(content.begin(), content.end(), '\n') + 1);
+    for (size_t start = 0; start < content.size();) {
+        auto end = content.find('\n', start);
+        if (end == std::string::npos) end = content.size();
+        if (end > start) lines.emplace_back(content, start, end - start);
+        start = end + 1;
     }
     return lines;
 }
@@ -170,9 +312,76 @@ std::string pipedInContent() {
     return content;
 }
 
+size_t pipedInContentToFile(const fs::path& path, bool append) {
+    // stream stdin to the file in fixed-size chunks so that memory usage stays flat
+    // no matter how much data gets piped in
+    size_t total = 0;
+#if defined(__linux__)
+    // no O_APPEND here: splice refuses append-mode outputs, so position the offset manually
+    if (int fileFd = open(path.string().data(), O_WRONLY | O_CREAT | (append ? 0 : O_TRUNC), S_IRUSR | S_IWUSR); fileFd != -1) {
+        if (append) lseek(fileFd, 0, SEEK_END);
+        // move the bytes from the stdin pipe into the file entirely within the kernel
+        ssize_t bytes = 0;
+        while ((bytes = splice(fileno(stdin), nullptr, fileFd, nullptr, 1 << 26, SPLICE_F_MORE)) > 0) {
+            successes.bytes += bytes;
+            total += bytes;
+        }
+        close(fileFd);
+        if (bytes == 0) return total;
+        if (!(errno == EINVAL && total == 0)) throw std::runtime_error("splice() failed"); // EINVAL right away means stdin isn't a pipe, so fall through
+    }
+#endif
+    std::ofstream file(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+#if !defined(_WIN32) && !defined(_WIN64)
+    int len = -1;
+    int stdinFd = fileno(stdin);
+    constexpr int bufferSize = 65536;
+    std::array<char, bufferSize> buffer;
+    while (len != 0) {
+        len = read(stdinFd, buffer.data(), bufferSize);
+        if (len <= 0) break;
+        file.write(buffer.data(), len);
+        successes.bytes += len;
+        total += len;
+    }
+#elif defined(_WIN32) || defined(_WIN64)
+    HANDLE hStdin = GetStdHandle(STD_INPUT_HANDLE);
+    DWORD dwRead;
+    CHAR chBuf[1024];
+    BOOL bSuccess = FALSE;
+
+    while (true) {
+        bSuccess = ReadFile(hStdin, chBuf, 1024, &dwRead, NULL);
+        if (!bSuccess || dwRead == 0) break;
+        file.write(chBuf, dwRead);
+        successes.bytes += dwRead;
+        total += dwRead;
+    }
+#endif
+    return total;
+}
+
 size_t writeToFile(const fs::path& path, const std::string& content, bool append) {
-    std::ofstream file(path, append ? std::ios::app : std::ios::trunc | std::ios::binary);
-    file << content;
+    if (append) {
+        std::ofstream file(path, std::ios::app | std::ios::binary);
+        file << content;
+        return content.size();
+    }
+    // write into a temp sibling and rename it over the target, so a process killed mid-write
+    // can never leave a half-written file that later invocations serve as clipboard content
+    fs::path temp(path);
+    temp += ".tmp" + std::to_string(thisPID());
+    {
+        std::ofstream file(temp, std::ios::trunc | std::ios::binary);
+        file << content;
+    }
+    std::error_code ec;
+    fs::rename(temp, path, ec);
+    if (ec) { // can't make new names here, so write in place like before
+        fs::remove(temp, ec);
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        file << content;
+    }
     return content.size();
 }
 
@@ -183,10 +392,8 @@ void deduplicate(auto& items) {
 
 void ignoreItemsPreemptively(auto& items) {
     if (!path.holdsIgnoreRegexes() || copying.items.empty() || action == Action::Ignore || io_type == IOType::Pipe) return;
-    auto regexes = path.ignoreRegexes();
-    for (const auto& regex : regexes)
-        for (const auto& item : items)
-            if (std::regex_match(item.string(), regex)) items.erase(std::find(items.begin(), items.end(), item));
+    auto regex = path.combinedIgnoreRegex();
+    items.erase(std::remove_if(items.begin(), items.end(), [&](const auto& item) { return std::regex_match(item.string(), regex); }), items.end());
 }
 
 bool userIsARobot() {
@@ -196,7 +403,7 @@ bool userIsARobot() {
 bool isAWriteAction() {
     using enum Action;
     return action == Cut || action == Copy || action == Add || action == Clear || action == Remove || action == Swap || action == Load || action == Import || action == History
-           || action == Edit;
+           || action == Edit || action == Undo;
 }
 
 bool isAClearingAction() {
@@ -204,6 +411,14 @@ bool isAClearingAction() {
     return action == Copy || action == Cut || action == Clear;
 }
 
+bool actionNeedsGUISync() {
+    using enum Action;
+    // metadata-only actions never look at clipboard content, so they shouldn't pay for a
+    // display-server handshake
+    if (action == Note || action == Ignore) return false;
+    return !isAClearingAction();
+}
+
 [[nodiscard]] CopyPolicy userDecision(const std::string& item) {
     using enum CopyPolicy;
 
@@ -228,30 +443,177 @@ bool isAClearingAction() {
     }
 }
 
+static std::vector<fs::path> deferred_removals;
+
+bool deferRemoval(const fs::path& target) {
+    // instantly rename the target into a hidden trash directory so the user doesn't wait on
+    // a big remove_all; a detached worker deletes it in the background at exit
+#if defined(HAVE_FORK)
+    if (isEnvTrueish("CLIPBOARD_NO_FORK")) return false;
+    static unsigned long removals = 0;
+    std::error_code ec;
+    auto trash_root = global_path.temporary / ".trash";
+    fs::create_directories(trash_root, ec);
+    if (ec) return false;
+    auto trash = trash_root / (std::to_string(thisPID()) + "." + std::to_string(removals++) + "." + target.filename().string());
+    fs::rename(target, trash, ec);
+    if (ec) return false;
+    deferred_removals.emplace_back(trash);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void flushRemovals() {
+    // the worker sweeps the whole trash directory, which also reaps anything an earlier
+    // cancelled run (SIGINT, indicator cancel) renamed in but never got to delete
+    auto trash_root = global_path.temporary / ".trash";
+    std::error_code ec;
+    bool leftovers = fs::is_directory(trash_root, ec) && !fs::is_empty(trash_root, ec);
+    if (deferred_removals.empty() && !leftovers) return;
+#if defined(HAVE_FORK)
+    if (!isEnvTrueish("CLIPBOARD_NO_FORK")) {
+        forker.fork([trash_root] { fs::remove_all(trash_root); });
+        deferred_removals.clear();
+        return;
+    }
+#endif
+    for (const auto& target : deferred_removals)
+        fs::remove_all(target);
+    deferred_removals.clear();
+}
+
+std::vector<fs::path> clearGenerations() {
+    // timestamped data.<time> siblings under the clipboard root, oldest first
+    std::vector<fs::path> generations;
+    std::error_code ec;
+    auto prefix = std::string(constants.data_directory) + ".";
+    for (const auto& entry : fs::directory_iterator(fs::path(path), ec))
+        if (entry.is_directory() && entry.path().filename().string().starts_with(prefix)) generations.emplace_back(entry.path());
+    std::sort(generations.begin(), generations.end());
+    return generations;
+}
+
+void reapGenerations() {
+    unsigned long budget = 3;
+    if (auto setting = getenv("CLIPBOARD_GENERATIONS"); setting != nullptr) {
+        try {
+            budget = std::stoul(setting);
+        } catch (...) {}
+    }
+    auto generations = clearGenerations();
+    for (size_t i = 0; i + budget < generations.size(); i++)
+        if (!deferRemoval(generations.at(i))) fs::remove_all(generations.at(i));
+}
+
+// The journaled append mode (CLIPBOARD_JOURNAL) turns contended cb add workloads from
+// lock-serialized into wait-free: writers append length-prefixed records to a shared journal
+// with O_APPEND, which the kernel serializes without any lock wait, and the next invocation
+// that holds the clipboard lock folds the journal into the raw data before reading it.
+
+bool journaledAddEnabled() {
+    return action == Action::Add && io_type != IOType::File && getenv("CLIPBOARD_JOURNAL") != nullptr && path.holdsRawData();
+}
+
+void appendToJournal(const std::string& content) {
+    auto record = "J " + std::to_string(content.size()) + "\n" + content;
+#if !defined(_WIN32) && !defined(_WIN64)
+    // a single O_APPEND write so concurrent appenders can't interleave records
+    int fd = open(path.metadata.journal.string().data(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+    if (fd != -1) {
+        auto written = write(fd, record.data(), record.size());
+        (void)written;
+        close(fd);
+        return;
+    }
+#endif
+    writeToFile(path.metadata.journal, record, true);
+}
+
+void mergeJournal() {
+    // runs under the clipboard lock; appenders mid-write between the rename and the read can
+    // lose at most the record they were writing that instant, which the O_APPEND open-per-
+    // record pattern keeps to a microsecond window
+    if (!fs::exists(path.metadata.journal)) return;
+    fs::path merging(path.metadata.journal.string() + ".merging");
+    std::error_code ec;
+    fs::rename(path.metadata.journal, merging, ec);
+    if (ec) return;
+    auto records = fileContents(merging);
+    std::string merged;
+    for (size_t position = 0; position < records.size();) {
+        if (records.compare(position, 2, "J ") != 0) break;
+        auto newline = records.find('\n', position);
+        if (newline == std::string::npos) break;
+        size_t size = 0;
+        try {
+            size = std::stoull(records.substr(position + 2, newline - position - 2));
+        } catch (...) {
+            break;
+        }
+        merged += records.substr(newline + 1, size);
+        position = newline + 1 + size;
+    }
+    if (!merged.empty()) writeToFile(path.data.raw, merged, true);
+    fs::remove(merging);
+}
+
 void clearData(bool force_clear = false) {
     using enum Action;
     if (force_clear || action == Cut || action == Copy) {
         fs::remove(path.metadata.originals);
         if (action == Clear && path.holdsRawData()) {
-            successes.bytes += fs::file_size(path.data.raw);
-            fs::remove(path.data.raw);
-        }
-        for (const auto& entry : fs::directory_iterator(path.data)) {
-            fs::remove_all(entry.path());
-            if (action == Clear) {
+            successes.bytes += fs::file_size(path.data.raw); // only counted here: the raw file leaves together with the rest of the directory below
+        } else if (action == Clear) {
+            for (const auto& entry : fs::directory_iterator(path.data))
                 incrementSuccessesForItem(entry);
+        }
+        if (action == Clear && !fs::is_empty(path.data)) {
+            // an explicit clear keeps the data around as a timestamped generation so cb undo
+            // can bring it back; the reaper below keeps the generation count bounded
+            auto generation = fs::path(path) / (std::string(constants.data_directory) + "." + std::to_string(std::time(nullptr)));
+            // the new generation has to sort after every existing one, not just be unique:
+            // a reaped same-second name could otherwise be reused, sort as oldest, and get
+            // reaped again immediately - taking the freshly cleared content with it
+            auto generations = clearGenerations();
+            while (fs::exists(generation) || (!generations.empty() && generation.filename() <= generations.back().filename()))
+                generation += "+";
+            std::error_code ec;
+            fs::rename(path.data, generation, ec);
+            if (!ec) {
+                fs::create_directories(path.data);
+                reapGenerations();
+                return;
             }
         }
+        // whisk the whole data directory away in one rename and delete it in the background
+        if (deferRemoval(path.data))
+            fs::create_directories(path.data);
+        else
+            for (const auto& entry : fs::directory_iterator(path.data))
+                fs::remove_all(entry.path());
     }
 }
 
 void convertFromGUIClipboard(const std::string& text) {
-    if (path.holdsRawData() && fileContents(path.data.raw) == text) return;
+    auto sameContent = [&] {
+        // check the stored hash first so invocations against a big unchanged clipboard skip
+        // reading the whole raw file; the full compare only runs to confirm a hash match
+        if (fs::exists(path.metadata.hash)) {
+            try {
+                if (std::stoull(fileContents(path.metadata.hash)) != contentHash(text)) return false;
+            } catch (...) {}
+        }
+        return fileContents(path.data.raw) == text;
+    };
+    if (path.holdsRawData() && sameContent()) return;
     clearData(true);
     auto regexes = path.ignoreRegexes();
     for (const auto& regex : regexes)
         if (std::regex_match(text, regex)) return;
     writeToFile(path.data.raw, text);
+    writeToFile(path.metadata.hash, std::to_string(contentHash(text))); // keep the fast path honest: the hash must track every raw write
 }
 
 void convertFromGUIClipboard(const ClipboardPaths& clipboard) {
@@ -307,7 +669,7 @@ void convertFromGUIClipboard(const ClipboardPaths& clipboard) {
 
     if (!copying.buffer.empty()) return {copying.buffer, copying.mime};
 
-    if (default_cb.holdsRawData()) return {fileContents(default_cb.data.raw), std::string(inferMIMEType(fileContents(default_cb.data.raw)).value_or("text/plain"))};
+    if (default_cb.holdsRawData()) return {fileContents(default_cb.data.raw), std::string(inferMIMETypeFromFile(default_cb.data.raw).value_or("text/plain"))};
 
     if (!copying.items.empty()) {
         std::vector<fs::path> paths;
@@ -324,6 +686,7 @@ void setupHandlers() {
     atexit([] {
         path.releaseLock();
         stopIndicator(true);
+        printProfile();
 #if defined(_WIN64) || defined(_WIN32)
         SetConsoleOutputCP(old_code_page);
 #endif
@@ -356,17 +719,22 @@ void setupHandlers() {
     });
 }
 
+void (*pending_language_setter)() = nullptr;
+std::string pending_theme;
+
 void setLocale() {
     try {
         locale = getenv("CLIPBOARD_LOCALE") ? getenv("CLIPBOARD_LOCALE") : std::locale("").name();
         std::locale::global(std::locale(locale));
     } catch (...) {}
+    // only note which language to use here; the tables get rewritten lazily on the first
+    // message print, so silent invocations skip the work
     if (locale.substr(0, 2) == "es")
-        setLanguageES();
+        pending_language_setter = setLanguageES;
     else if (locale.substr(0, 2) == "pt")
-        setLanguagePT();
+        pending_language_setter = setLanguagePT;
     else if (locale.substr(0, 2) == "tr")
-        setLanguageTR();
+        pending_language_setter = setLanguageTR;
 }
 
 void setClipboardName() {
@@ -407,7 +775,7 @@ void setupVariables(int& argc, char* argv[]) {
 
     progress_silent = getenv("CLIPBOARD_NOPROGRESS") ? true : false;
 
-    if (auto setting = getenv("CLIPBOARD_THEME"); setting != nullptr) setTheme(std::string(setting));
+    if (auto setting = getenv("CLIPBOARD_THEME"); setting != nullptr) pending_theme = setting; // applied lazily with the locale on first print
 
     if (argc == 0) return;
 
@@ -417,9 +785,13 @@ void setupVariables(int& argc, char* argv[]) {
 }
 
 void syncWithGUIClipboard(bool force) {
-    if ((!isAClearingAction() && clipboard_name == constants.default_clipboard_name && !getenv("CLIPBOARD_NOGUI")) || (force && !getenv("CLIPBOARD_NOGUI"))) {
+    // only the default clipboard ever mirrors the system selection; named and persistent
+    // clipboards never interact with it, so they skip the display-server handshake entirely
+    if (clipboard_name != constants.default_clipboard_name && !force) return;
+    if ((actionNeedsGUISync() && !getenv("CLIPBOARD_NOGUI")) || (force && !getenv("CLIPBOARD_NOGUI"))) {
         using enum ClipboardContentType;
-        auto content = getGUIClipboard(preferred_mime);
+        auto daemon_content = daemonGetGUIClipboard(preferred_mime); // much cheaper than a fresh display-server connection
+        auto content = daemon_content.has_value() ? daemon_content.value() : getGUIClipboard(preferred_mime);
         if (content.type() == Text) {
             convertFromGUIClipboard(content.text());
             copying.mime = !content.mime().empty() ? content.mime() : inferMIMEType(content.text()).value_or("text/plain");
@@ -455,11 +827,29 @@ template <typename T>
 Action getAction() {
     using enum Action;
     if (arguments.size() >= 1) {
-        for (const auto& entry : {Cut, Copy, Paste, Clear, Show, Edit, Add, Remove, Note, Swap, Status, Info, Load, Import, Export, History, Ignore}) {
-            if (flagIsPresent<bool>(actions[entry], "--") || flagIsPresent<bool>(action_shortcuts[entry], "--")) {
-                return entry;
+        // build the name/shortcut lookup once and scan the arguments a single time, instead
+        // of walking the argument list once per action name and again per shortcut
+        std::map<std::string_view, Action> lookup;
+        for (const auto& entry : {Cut, Copy, Paste, Clear, Show, Edit, Add, Remove, Note, Swap, Status, Info, Load, Import, Export, History, Ignore, Search, Undo}) {
+            lookup.emplace(actions[entry], entry);
+            lookup.emplace(action_shortcuts[entry], entry);
+        }
+        auto best = arguments.end();
+        Action best_action {};
+        auto best_rank = std::numeric_limits<unsigned int>::max();
+        for (auto argument = arguments.begin(); argument != arguments.end(); argument++) {
+            std::string_view name(*argument);
+            if (name.starts_with("--")) name.remove_prefix(2);
+            if (auto found = lookup.find(name); found != lookup.end() && static_cast<unsigned int>(found->second) < best_rank) {
+                best = argument;
+                best_action = found->second;
+                best_rank = static_cast<unsigned int>(found->second);
             }
         }
+        if (best != arguments.end()) {
+            arguments.erase(best);
+            return best_action;
+        }
         printf(no_valid_action_message().data(), arguments.at(0).data(), clipboard_invocation.data(), clipboard_invocation.data());
         exit(EXIT_FAILURE);
     } else if (!is_tty.in) {
@@ -482,7 +872,7 @@ IOType getIOType() {
     } else if (action == Remove) {
         if (!is_tty.in) return Pipe;
         return Text;
-    } else if (action == Note || action == Ignore || action == Swap || action == Load || action == Import || action == Export || action == History) {
+    } else if (action == Note || action == Ignore || action == Swap || action == Load || action == Import || action == Export || action == History || action == Search || action == Undo) {
         if (!is_tty.in && copying.items.empty()) return Pipe;
         return Text;
     }
@@ -491,6 +881,8 @@ IOType getIOType() {
 
 void setFlags() {
     if (flagIsPresent<bool>("--all") || flagIsPresent<bool>("-a")) all_option = true;
+    if (flagIsPresent<bool>("--archive") || flagIsPresent<bool>("-ar")) archive_option = true;
+    if (flagIsPresent<bool>("--sync") || flagIsPresent<bool>("-sy")) sync_option = true;
     if (flagIsPresent<bool>("--fast-copy") || flagIsPresent<bool>("-fc")) copying.use_safe_copy = false;
     if (auto flag = flagIsPresent<std::string>("--mime"); flag != "") preferred_mime = flag;
     if (auto flag = flagIsPresent<std::string>("-m"); flag != "") preferred_mime = flag;
@@ -544,6 +936,9 @@ void checkForNoItems() {
     }
 }
 
+static size_t indicator_items_size = 0;
+static bool indicator_items_size_known = false;
+
 void setupIndicator() {
     if (!is_tty.err || output_silent || progress_silent) return;
 
@@ -556,13 +951,29 @@ void setupIndicator() {
     const std::array<std::string_view, 22> spinner_steps {"╸         ", "━         ", "╺╸        ", " ━        ", " ╺╸       ", "  ━       ", "  ╺╸      ", "   ━      ",
                                                           "   ╺╸     ", "    ━     ", "    ╺╸    ", "     ━    ", "     ╺╸   ", "      ━   ", "      ╺╸  ", "       ━  ",
                                                           "       ╺╸ ", "        ━ ", "        ╺╸", "         ━", "         ╺", "          "};
-    auto itemsToProcess = [&] {
-        return std::distance(fs::directory_iterator(path.data), fs::directory_iterator());
-    };
-    static size_t items_size = (action == Action::Cut || action == Action::Copy) ? copying.items.size() : itemsToProcess();
+    auto items_size = indicator_items_size; // measured on the main thread before this thread existed
     if (items_size == 0) items_size++;
+    auto start_time = std::chrono::steady_clock::now();
+    auto elapsedSeconds = [&] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    };
     auto percent_done = [&] {
-        return std::to_string(((successes.files + successes.directories + copying.failedItems.size()) * 100) / items_size) + "%";
+        // percentage plus an ETA derived from the rate so far, all from counters the workers
+        // already maintain - no extra wakeups and no work added to the copy threads
+        auto done = successes.files + successes.directories + copying.failedItems.size();
+        auto progress = std::to_string((done * 100) / items_size) + "%";
+        auto elapsed = elapsedSeconds();
+        if (done > 0 && done < items_size && elapsed > 1.0) {
+            auto remaining = static_cast<unsigned long>((items_size - done) * (elapsed / done));
+            progress += " (" + std::to_string(remaining) + "s left)";
+        }
+        return progress;
+    };
+    auto bytes_progress = [&] {
+        auto bytes = successes.bytes.load(std::memory_order_relaxed);
+        auto progress = formatBytes(bytes);
+        if (auto elapsed = elapsedSeconds(); elapsed > 1.0) progress += " (" + formatBytes(bytes / elapsed) + "/s)";
+        return progress;
     };
     for (int i = 0; progress_state == ProgressState::Active; i == 21 ? i = 0 : i++) {
         auto display_progress = [&](const auto& formattedNum) {
@@ -574,7 +985,7 @@ void setupIndicator() {
         if (io_type == IOType::File)
             display_progress(percent_done().data());
         else if (io_type == IOType::Pipe)
-            display_progress(formatBytes(successes.bytes.load(std::memory_order_relaxed)).data());
+            display_progress(bytes_progress().data());
         else
             display_progress("");
     }
@@ -585,7 +996,7 @@ void setupIndicator() {
         if (io_type == IOType::File)
             fprintf(stderr, cancelled_with_progress_message().data(), actions[action].data(), percent_done().data());
         else if (io_type == IOType::Pipe)
-            fprintf(stderr, cancelled_with_progress_message().data(), actions[action].data(), formatBytes(successes.bytes.load(std::memory_order_relaxed)).data());
+            fprintf(stderr, cancelled_with_progress_message().data(), actions[action].data(), bytes_progress().data());
         else
             fprintf(stderr, cancelled_message().data(), actions[action].data());
         fflush(stderr);
@@ -596,15 +1007,25 @@ void setupIndicator() {
 }
 
 void startIndicator() { // If cancelled, leave cancelled
+    // measure the work size here on the main thread: the indicator thread must never touch
+    // the directory snapshot cache, since invalidateDirectorySnapshot can free the vector
+    // it would be reading
+    if (!indicator_items_size_known) {
+        indicator_items_size = (action == Action::Cut || action == Action::Copy) ? copying.items.size() : directorySnapshot(path.data).size();
+        indicator_items_size_known = true;
+    }
     ProgressState expect = ProgressState::Done;
     progress_state.compare_exchange_strong(expect, ProgressState::Active);
     indicator = std::thread(setupIndicator);
 }
 
 unsigned long long totalItemSize() {
-    unsigned long long total_item_size = 0;
+    std::atomic<unsigned long long> total_item_size {0};
     if ((action == Action::Cut || action == Action::Copy || action == Action::Add) && io_type == IOType::File) {
-        for (const auto& i : copying.items) {
+        // walk the item trees across worker threads so big copies don't pay a serial
+        // traversal of the whole source tree before the actual copying even starts
+        static std::mutex failed_items_mutex;
+        auto accountItem = [&](const fs::path& i) {
             try {
                 if (fs::is_directory(i))
                     for (const auto& entry : fs::recursive_directory_iterator(i))
@@ -612,8 +1033,25 @@ unsigned long long totalItemSize() {
                 else
                     total_item_size += fs::is_regular_file(i) ? fs::file_size(i) : 16;
             } catch (const fs::filesystem_error& e) {
+                std::lock_guard<std::mutex> lock(failed_items_mutex);
                 copying.failedItems.emplace_back(i.string(), e.code());
             }
+        };
+        auto threads = std::min(static_cast<unsigned long>(copying.items.size()), PerformAction::copyThreadAmount());
+        if (threads < 2) {
+            for (const auto& i : copying.items)
+                accountItem(i);
+        } else {
+            std::atomic<size_t> next_item {0};
+            std::vector<std::thread> workers;
+            for (unsigned long i = 0; i < threads; i++) {
+                workers.emplace_back([&] {
+                    for (size_t item = 0; (item = next_item.fetch_add(1)) < copying.items.size();)
+                        accountItem(copying.items.at(item));
+                });
+            }
+            for (auto& worker : workers)
+                worker.join();
         }
     } else if (action == Action::Paste && io_type == IOType::File) {
         for (const auto& entry : fs::recursive_directory_iterator(path.data))
@@ -642,7 +1080,7 @@ void removeOldFiles() {
     std::string line;
     while (std::getline(files, line)) {
         try {
-            fs::remove_all(line);
+            if (!fs::is_directory(line) || !deferRemoval(line)) fs::remove_all(line); // directories can be slow to delete, so push them to the background
         } catch (const fs::filesystem_error& e) {
             copying.failedItems.emplace_back(line, e.code());
         }
@@ -679,6 +1117,10 @@ void performAction() {
             ignoreRegex();
         else if (action == Status)
             statusJSON();
+        else if (action == Import)
+            importClipboards();
+        else if (action == Export)
+            exportClipboards();
     } else if (io_type == Text) {
         if (action == Copy || action == Cut)
             copyText();
@@ -710,6 +1152,12 @@ void performAction() {
             clear();
         else if (action == Show)
             show();
+        else if (action == History)
+            history();
+        else if (action == Search)
+            search();
+        else if (action == Undo)
+            undo();
     }
 }
 
@@ -725,7 +1173,21 @@ std::string getMIMEType() {
 void updateGUIClipboard(bool force) {
     if ((isAWriteAction() && clipboard_name == constants.default_clipboard_name && !getenv("CLIPBOARD_NOGUI"))
         || (force && !getenv("CLIPBOARD_NOGUI"))) { // only update GUI clipboard on write operations
-        writeToGUIClipboard(thisClipboard());
+#if defined(HAVE_FORK) && !defined(__APPLE__)
+        // not on macOS: AppKit and Core Foundation abort in a fork()ed child that never
+        // execs, so the pasteboard push has to stay synchronous there
+        if (!sync_option && !isEnvTrueish("CLIPBOARD_NO_FORK")) {
+            // hand the push to a detached worker so the prompt comes back without waiting on
+            // content serialization or the display server; --sync restores the old ordering
+            forker.fork([] {
+                auto content = thisClipboard();
+                if (!daemonSetGUIClipboard(content)) writeToGUIClipboard(content);
+            });
+            return;
+        }
+#endif
+        auto content = thisClipboard();
+        if (!daemonSetGUIClipboard(content)) writeToGUIClipboard(content);
     }
 }
 
@@ -771,33 +1233,63 @@ void showSuccesses() {
     }
 }
 
+#if !defined(CLIPBOARD_BENCHMARK) // the benchmark driver supplies its own main
 int main(int argc, char* argv[]) {
     try {
-        setupHandlers();
+        profiling_enabled = getenv("CLIPBOARD_PROFILE") != nullptr;
+
+        {
+            ProfileSpan span("setup");
+
+            setupHandlers();
+
+            setupVariables(argc, argv);
+
+            setLocale();
 
-        setupVariables(argc, argv);
+            setClipboardName();
 
-        setLocale();
+            setFlags();
 
-        setClipboardName();
+            setFilepaths();
 
-        setFlags();
+            if (!arguments.empty() && arguments.at(0) == "daemon") runDaemon(); // serve the GUI clipboard over a socket instead of performing an action
 
-        setFilepaths();
+            if (!arguments.empty() && arguments.at(0) == "watch") runWatcher(); // continuously sync with the GUI clipboard
 
-        action = getAction();
+#if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
+            if (!arguments.empty() && arguments.at(0) == "__delayed-render") {
+                // spawned by spawnDelayedRenderHelper to serve render requests in the background
+                if (arguments.size() >= 2) {
+                    clipboard_name = arguments.at(1);
+                    setFilepaths();
+                }
+#if defined(_WIN32) || defined(_WIN64)
+                setWindowsClipboardDataPipeDelayed();
+#else
+                serveDelayedRender();
+#endif
+                exit(EXIT_SUCCESS);
+            }
+#endif
 
-        copying.items.assign(arguments.begin(), arguments.end());
+            action = getAction();
 
-        io_type = getIOType();
+            copying.items.assign(arguments.begin(), arguments.end());
 
-        verifyAction();
+            io_type = getIOType();
 
-        startIndicator();
+            verifyAction();
 
-        (fs::create_directories(global_path.temporary), fs::create_directories(global_path.persistent));
+            startIndicator();
 
-        syncWithGUIClipboard();
+            (fs::create_directories(global_path.temporary), fs::create_directories(global_path.persistent));
+        }
+
+        {
+            ProfileSpan span("gui sync");
+            syncWithGUIClipboard();
+        }
 
         deduplicate(copying.items);
 
@@ -805,19 +1297,39 @@ int main(int argc, char* argv[]) {
 
         checkForNoItems();
 
-        if (action != Action::Info) path.getLock();
+        {
+            ProfileSpan span("lock");
+            if (action != Action::Info && !journaledAddEnabled()) path.getLock();
+        }
 
-        checkItemSize(totalItemSize());
+        if (action != Action::Info && !journaledAddEnabled()) mergeJournal(); // fold in any wait-free appends before anything reads the raw data
 
-        clearData();
+        {
+            ProfileSpan span("size check");
+            checkItemSize(totalItemSize());
+        }
 
-        performAction();
+        {
+            ProfileSpan span("action");
 
-        if (isAWriteAction()) path.applyIgnoreRegexes();
+            clearData();
+
+            invalidateDirectorySnapshot(path.data); // the GUI sync or the clear may have changed the data directory since the indicator peeked at it
+
+            performAction();
+
+            if (isAWriteAction()) {
+                path.applyIgnoreRegexes();
+                path.updateManifest();
+            }
+        }
 
         copying.mime = getMIMEType();
 
-        updateGUIClipboard();
+        {
+            ProfileSpan span("gui update");
+            updateGUIClipboard();
+        }
 
         stopIndicator();
 
@@ -826,6 +1338,8 @@ int main(int argc, char* argv[]) {
         showFailures();
 
         showSuccesses();
+
+        flushRemovals();
     } catch (const std::exception& e) {
         stopIndicator();
         fprintf(stderr, internal_error_message().data(), e.what());
@@ -836,3 +1350,4 @@ int main(int argc, char* argv[]) {
     else
         exit(EXIT_FAILURE);
 }
+#endif
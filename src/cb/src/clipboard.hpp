@@ -15,9 +15,13 @@
 #pragma once
 #include <array>
 #include <atomic>
+#include <charconv>
+#include <cstring>
 #include <condition_variable>
 #include <filesystem>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
 #include <regex>
 #include <string_view>
 #include <thread>
@@ -29,6 +33,12 @@
 #include <windows.h>
 #endif
 
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
 #include <clipboard/fork.hpp>
 #include <clipboard/gui.hpp>
 
@@ -44,6 +54,11 @@ namespace fs = std::filesystem;
 
 extern Forker forker;
 
+// a per-invocation monotonic arena backing the item bookkeeping: thousands of paths get
+// allocated bump-pointer style and released wholesale at exit instead of one heap round
+// trip each
+extern std::pmr::monotonic_buffer_resource arena;
+
 struct GlobalFilepaths {
     fs::path temporary;
     fs::path persistent;
@@ -67,6 +82,14 @@ struct Constants {
     std::string_view metadata_directory = "metadata";
     std::string_view import_export_directory = "Exported_Clipboards";
     std::string_view ignore_regex_name = "ignore";
+    std::string_view manifest_name = "manifest";
+    std::string_view history_name = "history";
+    std::string_view history_index_name = "history_index";
+    std::string_view hash_name = "hash";
+    std::string_view journal_name = "journal";
+    unsigned long default_history_entries = 100;
+    unsigned long long max_history_entry_bytes = 16 << 20;
+    unsigned long long max_history_bytes = 64 << 20;
 };
 constexpr Constants constants;
 
@@ -76,8 +99,8 @@ struct Copying {
     bool use_safe_copy = true;
     CopyPolicy policy = CopyPolicy::Unknown;
     fs::copy_options opts = fs::copy_options::overwrite_existing | fs::copy_options::recursive | fs::copy_options::copy_symlinks;
-    std::vector<fs::path> items;
-    std::vector<std::pair<std::string, std::error_code>> failedItems;
+    std::pmr::vector<fs::path> items {&arena};
+    std::pmr::vector<std::pair<std::string, std::error_code>> failedItems {&arena};
     std::string buffer;
     std::string mime;
 };
@@ -96,13 +119,43 @@ static auto thisPID() {
 }
 
 std::string fileContents(const fs::path& path);
+std::string readPrefix(const fs::path& path, size_t length);
+std::string filePreview(const fs::path& path, size_t length);
 std::vector<std::string> fileLines(const fs::path& path);
 
+unsigned long long contentHash(const std::string& content);
+unsigned long long fileContentHash(const fs::path& path);
+
+// One enumeration of a directory per invocation: filenames and types get read once into a
+// snapshot and shared by everything that needs them, instead of every consumer walking the
+// directory again and allocating a fresh filename string per access.
+struct SnapshotEntry {
+    fs::path path;
+    std::string filename;
+    bool is_directory;
+};
+const std::vector<SnapshotEntry>& directorySnapshot(const fs::path& directory);
+void invalidateDirectorySnapshot(const fs::path& directory);
+
 size_t writeToFile(const fs::path& path, const std::string& content, bool append = false);
 
 class Clipboard {
     fs::path root;
     std::string this_name;
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    int lock_fd = -1;
+#elif defined(_WIN32) || defined(_WIN64)
+    HANDLE lock_handle = INVALID_HANDLE_VALUE;
+#endif
+
+    // read-only handles memoize their stat-backed predicates: query actions call them
+    // several times per clipboard, and nothing mutates a clipboard behind such a handle
+    // within one invocation
+    bool read_only = false;
+    std::optional<bool> holds_data_cache;
+    std::optional<bool> holds_raw_cache;
+    std::optional<bool> holds_ignore_cache;
+    std::optional<bool> fresh_manifest_cache;
 
 public:
     bool is_persistent = false;
@@ -127,6 +180,11 @@ public:
         fs::path originals;
         fs::path lock;
         fs::path ignore;
+        fs::path manifest;
+        fs::path history;
+        fs::path history_index;
+        fs::path hash;
+        fs::path journal;
         operator fs::path() { return root; }
         operator fs::path() const { return root; }
         auto operator=(const auto& other) { return root = other; }
@@ -134,7 +192,9 @@ public:
     } metadata;
 
     Clipboard() = default;
-    Clipboard(const auto& clipboard_name) {
+    // query actions pass create = false to get a read-only handle that makes no directories,
+    // since a mkdir pair per clipboard adds up fast over many clipboards on slow filesystems
+    Clipboard(const auto& clipboard_name, const bool create = true) {
         this_name = clipboard_name;
 
         is_persistent = isPersistent(this_name) || getenv("CLIPBOARD_ALWAYS_PERSIST");
@@ -155,8 +215,25 @@ public:
 
         metadata.ignore = metadata / constants.ignore_regex_name;
 
-        fs::create_directories(data);
-        fs::create_directories(metadata);
+        metadata.manifest = metadata / constants.manifest_name;
+
+        metadata.history = metadata / constants.history_name;
+
+        metadata.history_index = metadata / constants.history_index_name;
+
+        metadata.hash = metadata / constants.hash_name;
+
+        metadata.journal = metadata / constants.journal_name;
+
+        read_only = !create;
+
+        if (create) {
+            // cheap read-only stats first: for the usual case of an existing clipboard this
+            // turns two mkdir write syscalls per invocation into two lookups
+            std::error_code ec;
+            if (!fs::is_directory(data, ec)) fs::create_directories(data);
+            if (!fs::is_directory(metadata, ec)) fs::create_directories(metadata);
+        }
     }
     operator fs::path() { return root; }
     operator fs::path() const { return root; }
@@ -164,12 +241,27 @@ public:
     auto operator/(const auto& other) { return root / other; }
     std::string string() { return root.string(); }
     bool holdsData() {
-        if (!fs::exists(data) || fs::is_empty(data)) return false;
-        if (fs::exists(data.raw) && fs::is_empty(data.raw)) return false;
-        return true;
+        if (read_only && holds_data_cache.has_value()) return holds_data_cache.value();
+        bool result = true;
+        if (!fs::exists(data) || fs::is_empty(data))
+            result = false;
+        else if (fs::exists(data.raw) && fs::is_empty(data.raw))
+            result = false;
+        if (read_only) holds_data_cache = result;
+        return result;
+    }
+    bool holdsRawData() {
+        if (read_only && holds_raw_cache.has_value()) return holds_raw_cache.value();
+        bool result = fs::exists(data.raw) && !fs::is_empty(data.raw);
+        if (read_only) holds_raw_cache = result;
+        return result;
+    }
+    bool holdsIgnoreRegexes() {
+        if (read_only && holds_ignore_cache.has_value()) return holds_ignore_cache.value();
+        bool result = fs::exists(metadata.ignore) && !fs::is_empty(metadata.ignore);
+        if (read_only) holds_ignore_cache = result;
+        return result;
     }
-    bool holdsRawData() { return fs::exists(data.raw) && !fs::is_empty(data.raw); }
-    bool holdsIgnoreRegexes() { return fs::exists(metadata.ignore) && !fs::is_empty(metadata.ignore); }
     std::vector<std::regex> ignoreRegexes() {
         std::vector<std::regex> regexes;
         if (!holdsIgnoreRegexes()) return regexes;
@@ -177,43 +269,132 @@ public:
             regexes.emplace_back(line);
         return regexes;
     }
+    std::regex combinedIgnoreRegex() {
+        // compile every ignore pattern into one alternation so that filtering is a single
+        // pass no matter how many patterns there are
+        std::string combined;
+        for (const auto& line : fileLines(metadata.ignore))
+            combined += "(?:" + line + ")|";
+        if (!combined.empty()) combined.pop_back();
+        return std::regex(combined);
+    }
     void applyIgnoreRegexes() {
         if (!holdsIgnoreRegexes()) return;
-        auto regexes = ignoreRegexes();
+        auto regex = combinedIgnoreRegex();
         if (holdsRawData())
-            for (const auto& regex : regexes)
-                writeToFile(data.raw, std::regex_replace(fileContents(data.raw), regex, ""));
+            writeToFile(data.raw, std::regex_replace(fileContents(data.raw), regex, ""));
         else
-            for (const auto& regex : regexes)
-                for (const auto& entry : fs::directory_iterator(data))
-                    if (std::regex_match(entry.path().filename().string(), regex)) fs::remove_all(entry.path());
+            for (const auto& entry : fs::directory_iterator(data))
+                if (std::regex_match(entry.path().filename().string(), regex)) fs::remove_all(entry.path());
+    }
+    bool hasFreshManifest() {
+        if (read_only && fresh_manifest_cache.has_value()) return fresh_manifest_cache.value();
+        auto memoize = [&](bool result) {
+            if (read_only) fresh_manifest_cache = result;
+            return result;
+        };
+        std::error_code ec;
+        auto manifest_time = fs::last_write_time(metadata.manifest, ec);
+        if (ec) return memoize(false);
+        auto data_time = fs::last_write_time(data, ec);
+        if (ec) return memoize(false);
+        if (manifest_time < data_time) return memoize(false);
+        auto raw_time = fs::last_write_time(data.raw, ec);
+        if (!ec && manifest_time < raw_time) return memoize(false); // modifying the raw file in place doesn't bump the directory's mtime
+        return memoize(true);
+    }
+    void updateManifest() {
+        // cache a one-file summary of what this clipboard holds so that querying actions can
+        // render it with one sequential read instead of a directory walk
+        std::string content;
+        if (holdsRawData()) {
+            content = "raw\n" + filePreview(data.raw, 500) + "\n";
+            writeToFile(metadata.hash, std::to_string(fileContentHash(data.raw))); // lets the GUI sync skip full-content compares
+        } else if (holdsData()) {
+            content = "items\n";
+            for (const auto& entry : fs::directory_iterator(data))
+                content += entry.path().filename().string() + "\n";
+        }
+        writeToFile(metadata.manifest, content);
     }
+    std::vector<std::string> manifestLines() { return fileLines(metadata.manifest); }
     bool isUnused() {
         if (holdsData()) return false;
         if (fs::exists(metadata.notes) && !fs::is_empty(metadata.notes)) return false;
         if (fs::exists(metadata.originals) && !fs::is_empty(metadata.originals)) return false;
         return true;
     }
-    bool isLocked() { return fs::exists(metadata.lock); }
+    // Locking is a kernel advisory lock on the lock file, so waiters block in the kernel and
+    // wake as soon as the holder releases instead of polling. The PID written into the file is
+    // kept purely for diagnostics in info().
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    bool isLocked() {
+        int fd = open(metadata.lock.string().data(), O_RDONLY);
+        if (fd == -1) return false;
+        bool locked = flock(fd, LOCK_EX | LOCK_NB) == -1;
+        if (!locked) flock(fd, LOCK_UN);
+        close(fd);
+        return locked;
+    }
     void getLock() {
+        if (lock_fd != -1) return;
         if (isLocked()) {
-            auto pid = std::stoi(fileContents(metadata.lock));
-#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
-            if (getpgrp() == getpgid(pid)) return; // if we're in the same process group, we're probably in a self-referencing pipe like cb | cb
-#endif
-            while (true) {
-#if defined(_WIN32) || defined(_WIN64)
-                if (WaitForSingleObject(OpenProcess(SYNCHRONIZE, FALSE, pid), 0) == WAIT_OBJECT_0) break;
-#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
-                if (kill(pid, 0) == -1) break;
-#endif
-                if (!isLocked()) break;
-                std::this_thread::sleep_for(std::chrono::milliseconds(250));
-            }
+            try {
+                auto pid = std::stoi(fileContents(metadata.lock));
+                if (getpgrp() == getpgid(pid)) return; // if we're in the same process group, we're probably in a self-referencing pipe like cb | cb
+            } catch (...) {}
+        }
+        lock_fd = open(metadata.lock.string().data(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+        if (lock_fd == -1) return;
+        flock(lock_fd, LOCK_EX);
+        // write the diagnostic PID through the held descriptor: renaming a fresh file over
+        // the lock would detach the flock everyone else is waiting on
+        auto pid = std::to_string(thisPID());
+        if (ftruncate(lock_fd, 0) == 0) {
+            auto written = write(lock_fd, pid.data(), pid.size());
+            (void)written;
         }
-        writeToFile(metadata.lock, std::to_string(thisPID()));
     }
-    void releaseLock() { fs::remove(metadata.lock); }
+    void releaseLock() {
+        if (lock_fd == -1) return;
+        flock(lock_fd, LOCK_UN);
+        close(lock_fd);
+        lock_fd = -1;
+    }
+#elif defined(_WIN32) || defined(_WIN64)
+    bool isLocked() {
+        HANDLE probe = CreateFileA(
+                metadata.lock.string().data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+        );
+        if (probe == INVALID_HANDLE_VALUE) return false;
+        OVERLAPPED overlapped {};
+        bool locked = !LockFileEx(probe, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped);
+        if (!locked) UnlockFileEx(probe, 0, 1, 0, &overlapped);
+        CloseHandle(probe);
+        return locked;
+    }
+    void getLock() {
+        if (lock_handle != INVALID_HANDLE_VALUE) return;
+        lock_handle = CreateFileA(
+                metadata.lock.string().data(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL
+        );
+        if (lock_handle == INVALID_HANDLE_VALUE) return;
+        OVERLAPPED overlapped {};
+        LockFileEx(lock_handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped);
+        auto pid = std::to_string(thisPID());
+        DWORD written = 0;
+        SetFilePointer(lock_handle, 0, nullptr, FILE_BEGIN);
+        SetEndOfFile(lock_handle);
+        WriteFile(lock_handle, pid.data(), pid.size(), &written, nullptr); // the held handle, so the lock stays attached
+    }
+    void releaseLock() {
+        if (lock_handle == INVALID_HANDLE_VALUE) return;
+        OVERLAPPED overlapped {};
+        UnlockFileEx(lock_handle, 0, 1, 0, &overlapped);
+        CloseHandle(lock_handle);
+        lock_handle = INVALID_HANDLE_VALUE;
+    }
+#endif
     std::string name() { return this_name; }
 };
 extern Clipboard path;
@@ -232,6 +413,8 @@ extern bool confirmation_silent;
 extern bool no_color;
 extern bool no_emoji;
 extern bool all_option;
+extern bool archive_option;
+extern bool sync_option;
 
 extern std::string preferred_mime;
 extern std::vector<std::string> available_mimes;
@@ -244,10 +427,12 @@ extern std::atomic<ProgressState> progress_state;
 static std::thread indicator;
 
 struct Successes {
-    std::atomic<unsigned long> files;
-    std::atomic<unsigned long> directories;
-    std::atomic<unsigned long long> bytes;
-    std::atomic<unsigned long> clipboards;
+    // each counter gets its own cache line so the copy workers and the indicator thread
+    // don't ping-pong a shared line between cores
+    alignas(64) std::atomic<unsigned long> files;
+    alignas(64) std::atomic<unsigned long> directories;
+    alignas(64) std::atomic<unsigned long long> bytes;
+    alignas(64) std::atomic<unsigned long> clipboards;
 };
 extern Successes successes;
 
@@ -258,7 +443,7 @@ struct IsTTY {
 };
 extern IsTTY is_tty;
 
-enum class Action : unsigned int { Cut, Copy, Paste, Clear, Show, Edit, Add, Remove, Note, Swap, Status, Info, Load, Import, Export, History, Ignore };
+enum class Action : unsigned int { Cut, Copy, Paste, Clear, Show, Edit, Add, Remove, Note, Swap, Status, Info, Load, Import, Export, History, Ignore, Search, Undo };
 
 extern Action action;
 
@@ -266,16 +451,39 @@ enum class IOType : unsigned int { File, Pipe, Text };
 
 extern IOType io_type;
 
+// set by setLocale/setupVariables and run on the first message or action-name lookup, so
+// invocations that never print anything skip the locale and theme work entirely
+extern void (*pending_language_setter)();
+extern std::string pending_theme;
+
+void setTheme(const std::string& theme);
+
+inline void applyPendingLanguage() {
+    if (!pending_theme.empty()) {
+        auto theme = pending_theme;
+        pending_theme.clear();
+        setTheme(theme);
+    }
+    if (pending_language_setter != nullptr) {
+        auto setter = pending_language_setter;
+        pending_language_setter = nullptr;
+        setter();
+    }
+}
+
 template <typename T, size_t N>
 class EnumArray : public std::array<T, N> {
 public:
-    T& operator[](Action index) { return std::array<T, N>::operator[](static_cast<unsigned int>(index)); } // switch to std::to_underlying when available
+    T& operator[](Action index) {
+        applyPendingLanguage(); // the tables get swapped out lazily for the chosen locale
+        return std::array<T, N>::operator[](static_cast<unsigned int>(index));
+    } // switch to std::to_underlying when available
 };
 
-extern EnumArray<std::string_view, 17> actions;
-extern EnumArray<std::string_view, 17> action_shortcuts;
-extern EnumArray<std::string_view, 17> doing_action;
-extern EnumArray<std::string_view, 17> did_action;
+extern EnumArray<std::string_view, 19> actions;
+extern EnumArray<std::string_view, 19> action_shortcuts;
+extern EnumArray<std::string_view, 19> doing_action;
+extern EnumArray<std::string_view, 19> did_action;
 
 extern std::array<std::pair<std::string_view, std::string_view>, 7> colors;
 
@@ -287,14 +495,40 @@ public:
 };
 
 static std::string formatMessage(const std::string_view& str, bool colorful = !no_color) {
-    std::string temp(str); // a string to do scratch work on
-    auto replaceThis = [&](const std::string_view& str, const std::string_view& with) {
-        for (size_t i = 0; (i = temp.find(str, i)) != std::string::npos; i += with.length())
-            temp.replace(i, str.length(), with);
-    };
-    for (const auto& key : colors) // iterate over all the possible colors to replace
-        replaceThis(key.first, colorful ? key.second : "");
+    applyPendingLanguage();
+    // a single sweep that jumps from one '[' to the next with memchr and substitutes the
+    // matching tag in place, instead of one full find/replace scan per color - so rendering
+    // cost no longer grows with the number of tags in the table
+    std::string temp;
+    temp.reserve(str.size() + 64);
+    size_t position = 0;
+    while (position < str.size()) {
+        auto open = static_cast<const char*>(memchr(str.data() + position, '[', str.size() - position));
+        if (open == nullptr) {
+            temp.append(str, position, std::string_view::npos);
+            break;
+        }
+        size_t open_index = open - str.data();
+        temp.append(str, position, open_index - position);
+        bool replaced = false;
+        for (const auto& key : colors) {
+            if (str.compare(open_index, key.first.size(), key.first) == 0) {
+                if (colorful) temp += key.second;
+                position = open_index + key.first.size();
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) {
+            temp += '[';
+            position = open_index + 1;
+        }
+    }
     if (no_emoji) {
+        auto replaceThis = [&](const std::string_view& target, const std::string_view& with) {
+            for (size_t i = 0; (i = temp.find(target, i)) != std::string::npos; i += with.length())
+                temp.replace(i, target.length(), with);
+        };
         replaceThis("✅", "✓");
         replaceThis("❌", "✗");
         replaceThis("🟡", "-");
@@ -308,22 +542,53 @@ void incrementSuccessesForItem(const auto& item) {
     fs::is_directory(item) ? successes.directories++ : successes.files++;
 }
 
+inline void incrementSuccessesForItem(const fs::directory_entry& entry) {
+    entry.is_directory() ? successes.directories++ : successes.files++; // reuses the status cached during iteration instead of another stat
+}
+
+inline void incrementSuccessesForItem(const SnapshotEntry& entry) {
+    entry.is_directory ? successes.directories++ : successes.files++;
+}
+
 class Message {
 private:
     std::string_view internal_message;
+    mutable std::string formatted; // formatting and length are memoized since messages get printed repeatedly
+    mutable size_t raw_length = std::string::npos;
 
 public:
     Message(const auto& message) : internal_message(std::move(message)) {}
-    std::string operator()() const { return std::move(formatMessage(internal_message)); }
-    size_t rawLength() const { return std::regex_replace(std::string(internal_message), std::regex("\\[[a-z]+\\]"), "").length(); }
+    std::string operator()() const {
+        applyPendingLanguage(); // may reassign the message tables, including this one
+        if (formatted.empty()) formatted = formatMessage(internal_message);
+        return formatted;
+    }
+    size_t rawLength() const {
+        if (raw_length != std::string::npos) return raw_length;
+        size_t length = 0;
+        for (size_t i = 0; i < internal_message.size(); i++) {
+            if (internal_message.at(i) == '[') {
+                auto end = internal_message.find(']', i + 1);
+                bool is_tag = end != std::string_view::npos && end > i + 1;
+                for (size_t j = i + 1; is_tag && j < end; j++)
+                    if (internal_message.at(j) < 'a' || internal_message.at(j) > 'z') is_tag = false;
+                if (is_tag) {
+                    i = end;
+                    continue;
+                }
+            }
+            length++;
+        }
+        return raw_length = length;
+    }
 };
 
 std::string formatNumbers(const auto& num) {
-    static std::stringstream ss;
-    ss.str(std::string());
-    ss << std::fixed << std::setprecision(2);
-    ss << num;
-    return ss.str();
+    // to_chars into a stack buffer: no locale, no allocation surprises, and safe to call from
+    // the indicator thread and the copy workers at the same time
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(num), std::chars_format::fixed, 2);
+    return std::string(buffer, result.ptr);
 }
 
 std::string formatBytes(const auto& bytes) {
@@ -343,6 +608,8 @@ void setupItems(int& argc, char* argv[]);
 void setClipboardName(int& argc, char* argv[]);
 void setupVariables(int& argc, char* argv[]);
 void createTempDirectory();
+void convertFromGUIClipboard(const std::string& text);
+void convertFromGUIClipboard(const ClipboardPaths& clipboard);
 void syncWithGUIClipboard(bool force = false);
 void syncWithGUIClipboard(const std::string& text);
 void syncWithGUIClipboard(const ClipboardPaths& clipboard);
@@ -358,6 +625,13 @@ bool stopIndicator(bool change_condition_variable = true);
 void checkItemSize();
 TerminalSize thisTerminalSize();
 void clearData(bool force_clear);
+std::vector<fs::path> clearGenerations();
+void reapGenerations();
+bool deferRemoval(const fs::path& target);
+bool journaledAddEnabled();
+void appendToJournal(const std::string& content);
+void mergeJournal();
+void flushRemovals();
 void copyFiles();
 void removeOldFiles();
 bool userIsARobot();
@@ -366,10 +640,10 @@ void clearClipboard();
 void performAction();
 void updateGUIClipboard(bool force = false);
 std::string pipedInContent();
+size_t pipedInContentToFile(const fs::path& path, bool append = false);
 void showFailures();
 void showSuccesses();
 [[nodiscard]] CopyPolicy userDecision(const std::string& item);
-void setTheme(const std::string& theme);
 
 extern Message help_message;
 extern Message check_clipboard_status_message;
@@ -413,7 +687,17 @@ extern ClipboardContent getGUIClipboard(const std::string& requested_mime);
 extern void writeToGUIClipboard(const ClipboardContent& clipboard);
 extern const bool GUIClipboardSupportsCut;
 
+std::optional<ClipboardContent> daemonGetGUIClipboard(const std::string& requested_mime);
+bool daemonSetGUIClipboard(const ClipboardContent& clipboard);
+[[noreturn]] void runDaemon();
+[[noreturn]] void runWatcher();
+
+#if defined(__APPLE__)
+void serveDelayedRender();
+#endif
+
 namespace PerformAction {
+unsigned long copyThreadAmount();
 void copyItem(const fs::path& f);
 void copy();
 void copyText();
@@ -441,4 +725,10 @@ void exportClipboards();
 void infoJSON();
 void ignoreRegex();
 void statusJSON();
+void history();
+void appendToHistory(const std::string& content);
+void appendFileToHistory(const fs::path& file);
+std::vector<std::pair<std::string, bool>> clipboardsWithContent();
+void search();
+void undo();
 } // namespace PerformAction
\ No newline at end of file
@@ -0,0 +1,322 @@
+/*  The Clipboard Project - Cut, copy, and paste anything, anywhere, all from the terminal.
+    Copyright (C) 2023 Jackson Huff and other contributors on GitHub.com
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.*/
+#include "clipboard.hpp"
+
+#if defined(_WIN32) || defined(_WIN64)
+
+// The daemon relies on Unix domain sockets, so it's not available on Windows yet.
+std::optional<ClipboardContent> daemonGetGUIClipboard(const std::string&) {
+    return std::nullopt;
+}
+bool daemonSetGUIClipboard(const ClipboardContent&) {
+    return false;
+}
+void runDaemon() {
+    fprintf(stderr, "%s", formatMessage("[error]❌ The daemon isn't available on this platform yet.[blank]\n").data());
+    exit(EXIT_FAILURE);
+}
+void runWatcher() {
+    fprintf(stderr, "%s", formatMessage("[error]❌ Watch mode isn't available on this platform yet.[blank]\n").data());
+    exit(EXIT_FAILURE);
+}
+
+#else
+
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+// The daemon holds the display-server connection and the current GUI clipboard content open
+// across invocations, so scripted loops of cb commands don't pay a fresh X11/Wayland handshake
+// every time. The CLI talks to it over a Unix socket with a tiny line-based protocol:
+//   GET\n                                -> TEXT <mime bytes> <text bytes>\n<mime><text>
+//                                         | PATHS <action> <bytes>\n<newline-separated paths>
+//                                         | NONE\n
+//   SET TEXT <mime bytes> <text bytes>\n<mime><text>  -> OK\n
+//   SET PATHS <action> <bytes>\n<paths>               -> OK\n
+
+static fs::path daemonSocketPath() {
+    return global_path.temporary / "daemon_socket";
+}
+
+static bool writeAll(int fd, const void* data, size_t length) {
+    auto bytes = static_cast<const char*>(data);
+    while (length > 0) {
+        auto written = write(fd, bytes, length);
+        if (written <= 0) return false;
+        bytes += written;
+        length -= written;
+    }
+    return true;
+}
+
+static bool readAll(int fd, void* data, size_t length) {
+    auto bytes = static_cast<char*>(data);
+    while (length > 0) {
+        auto got = read(fd, bytes, length);
+        if (got <= 0) return false;
+        bytes += got;
+        length -= got;
+    }
+    return true;
+}
+
+static std::string readLine(int fd) {
+    std::string line;
+    for (char byte = 0; read(fd, &byte, 1) == 1 && byte != '\n';)
+        line += byte;
+    return line;
+}
+
+static void sendContent(int fd, const ClipboardContent& content) {
+    if (content.type() == ClipboardContentType::Text) {
+        auto header = "TEXT " + std::to_string(content.mime().size()) + " " + std::to_string(content.text().size()) + "\n";
+        writeAll(fd, header.data(), header.size());
+        writeAll(fd, content.mime().data(), content.mime().size());
+        writeAll(fd, content.text().data(), content.text().size());
+    } else if (content.type() == ClipboardContentType::Paths) {
+        std::string body;
+        for (const auto& entry : content.paths().paths())
+            body += entry.string() + "\n";
+        auto header = "PATHS " + std::to_string(content.paths().action() == ClipboardPathsAction::Cut ? 1 : 0) + " " + std::to_string(body.size()) + "\n";
+        writeAll(fd, header.data(), header.size());
+        writeAll(fd, body.data(), body.size());
+    } else {
+        writeAll(fd, "NONE\n", 5);
+    }
+}
+
+static std::optional<ClipboardContent> receiveContent(int fd, const std::string& header) {
+    try {
+        if (header.starts_with("TEXT ")) {
+            auto space = header.find(' ', 5);
+            size_t mime_length = std::stoull(header.substr(5, space - 5));
+            size_t text_length = std::stoull(header.substr(space + 1));
+            std::string mime(mime_length, '\0');
+            std::string text(text_length, '\0');
+            if (!readAll(fd, mime.data(), mime_length) || !readAll(fd, text.data(), text_length)) return std::nullopt;
+            return ClipboardContent(std::move(text), mime);
+        } else if (header.starts_with("PATHS ")) {
+            auto space = header.find(' ', 6);
+            auto action = header.substr(6, space - 6) == "1" ? ClipboardPathsAction::Cut : ClipboardPathsAction::Copy;
+            size_t body_length = std::stoull(header.substr(space + 1));
+            std::string body(body_length, '\0');
+            if (!readAll(fd, body.data(), body_length)) return std::nullopt;
+            std::vector<fs::path> paths;
+            for (size_t start = 0, end = 0; (end = body.find('\n', start)) != std::string::npos; start = end + 1)
+                paths.emplace_back(body.substr(start, end - start));
+            return ClipboardContent(std::move(paths), action);
+        } else if (header == "NONE") {
+            return ClipboardContent();
+        }
+    } catch (...) {}
+    return std::nullopt;
+}
+
+static int connectToDaemon() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) return -1;
+    struct sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    auto socket_path = daemonSocketPath().string();
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        close(fd);
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path.data());
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+std::optional<ClipboardContent> daemonGetGUIClipboard(const std::string& requested_mime) {
+    int fd = connectToDaemon();
+    if (fd == -1) return std::nullopt;
+    auto request = "GET " + requested_mime + "\n";
+    if (!writeAll(fd, request.data(), request.size())) {
+        close(fd);
+        return std::nullopt;
+    }
+    auto content = receiveContent(fd, readLine(fd));
+    close(fd);
+    return content;
+}
+
+bool daemonSetGUIClipboard(const ClipboardContent& clipboard) {
+    int fd = connectToDaemon();
+    if (fd == -1) return false;
+    std::string set("SET ");
+    writeAll(fd, set.data(), set.size());
+    sendContent(fd, clipboard);
+    bool acknowledged = readLine(fd) == "OK";
+    close(fd);
+    return acknowledged;
+}
+
+static unsigned long long contentFingerprint(const ClipboardContent& content);
+
+void runDaemon() {
+    auto socket_path = daemonSocketPath().string();
+    fs::remove(socket_path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == -1) {
+        fprintf(stderr, "%s", formatMessage("[error]❌ CB couldn't create the daemon socket.[blank]\n").data());
+        exit(EXIT_FAILURE);
+    }
+    struct sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        fprintf(stderr, "%s", formatMessage("[error]❌ The daemon socket path is too long.[blank]\n").data());
+        exit(EXIT_FAILURE);
+    }
+    strcpy(address.sun_path, socket_path.data());
+    if (bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1 || listen(listener, 8) == -1) {
+        fprintf(stderr, "%s", formatMessage("[error]❌ CB couldn't listen on the daemon socket. [help]Is another daemon already running?[blank]\n").data());
+        exit(EXIT_FAILURE);
+    }
+
+    signal(SIGPIPE, SIG_IGN); // a client going away mid-reply shouldn't kill the daemon
+
+    // fetch the GUI clipboard once upfront so that the first client request is already cached
+    ClipboardContent cached(getGUIClipboard(""));
+    auto cached_fingerprint = contentFingerprint(cached);
+
+    fprintf(stderr, formatMessage("[success]✅ Serving the GUI clipboard at [bold]%s[blank]\n").data(), socket_path.data());
+
+    while (true) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client == -1) continue;
+        // a stalled or dead peer must never wedge the daemon on a blocking read or write
+        struct timeval timeout {5, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        auto request = readLine(client);
+        if (request.starts_with("GET")) {
+            auto requested_mime = request.size() > 4 ? request.substr(4) : std::string();
+            if (!requested_mime.empty()) {
+                // a specific mime bypasses the cache entirely: the cache only ever holds the
+                // default-mime rendition
+                sendContent(client, getGUIClipboard(requested_mime));
+                close(client);
+                continue;
+            }
+            // no selection-change events reach us through the dlopen'd backends, so re-read
+            // the selection and swap the cache only when the fingerprint actually changed -
+            // otherwise any other application's copy would be served stale forever
+            auto current = getGUIClipboard("");
+            if (current.type() != ClipboardContentType::Empty) { // an empty read may just mean no display; keep serving the cache then
+                if (auto fingerprint = contentFingerprint(current); fingerprint != cached_fingerprint) {
+                    cached = std::move(current);
+                    cached_fingerprint = fingerprint;
+                }
+            }
+            sendContent(client, cached);
+        } else if (request.starts_with("SET ")) {
+            if (auto content = receiveContent(client, request.substr(4)); content.has_value()) {
+                cached = content.value();
+                cached_fingerprint = contentFingerprint(cached);
+                writeToGUIClipboard(cached);
+                writeAll(client, "OK\n", 3);
+            }
+        }
+        close(client);
+    }
+}
+
+static unsigned long long contentFingerprint(const ClipboardContent& content) {
+    // a cheap FNV-1a fingerprint so the daemon and the watcher can tell "changed" from
+    // "same" without comparing full buffers every cycle
+    unsigned long long hash = 14695981039346656037ull;
+    auto mix = [&](const std::string& text) {
+        for (const char byte : text)
+            hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ull;
+    };
+    // the type participates too: text that happens to spell a file's path must not collide
+    // with the path list offering that file
+    hash = (hash ^ static_cast<unsigned char>(content.type())) * 1099511628211ull;
+    if (content.type() == ClipboardContentType::Text) {
+        mix(content.text());
+    } else if (content.type() == ClipboardContentType::Paths) {
+        for (const auto& entry : content.paths().paths())
+            mix(entry.string());
+    }
+    return hash;
+}
+
+void runWatcher() {
+    // continuously keep this clipboard and the GUI clipboard in sync: local changes get
+    // noticed through inotify, and GUI changes through fingerprint-gated polls (which are
+    // nearly free when they go through a running daemon's cache)
+    auto currentGUIClipboard = [] {
+        auto daemon_content = daemonGetGUIClipboard("");
+        return daemon_content.has_value() ? daemon_content.value() : getGUIClipboard("");
+    };
+
+    int notify = -1;
+#if defined(__linux__)
+    notify = inotify_init1(IN_NONBLOCK);
+    if (notify != -1) inotify_add_watch(notify, fs::path(path.data).string().data(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM);
+#endif
+    auto drainNotifications = [&] {
+        bool any = false;
+        if (notify == -1) return any;
+        std::array<char, 4096> buffer;
+        while (read(notify, buffer.data(), buffer.size()) > 0)
+            any = true;
+        return any;
+    };
+
+    auto last_fingerprint = contentFingerprint(currentGUIClipboard());
+
+    fprintf(stderr, formatMessage("[success]✅ Watching clipboard [bold]%s[blank]\n").data(), clipboard_name.data());
+
+    while (true) {
+        if (notify != -1) {
+            struct pollfd entry {notify, POLLIN, 0};
+            poll(&entry, 1, 500);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+
+        if (drainNotifications()) {
+            // something changed locally, so push it out to the GUI clipboard
+            updateGUIClipboard(true);
+            last_fingerprint = contentFingerprint(currentGUIClipboard());
+            continue;
+        }
+
+        auto content = currentGUIClipboard();
+        auto fingerprint = contentFingerprint(content);
+        if (fingerprint == last_fingerprint) continue;
+        last_fingerprint = fingerprint;
+        if (content.type() == ClipboardContentType::Text)
+            convertFromGUIClipboard(content.text());
+        else if (content.type() == ClipboardContentType::Paths)
+            convertFromGUIClipboard(content.paths());
+        drainNotifications(); // our own writes shouldn't bounce straight back to the GUI
+    }
+}
+
+#endif
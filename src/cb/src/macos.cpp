@@ -15,6 +15,9 @@
 #include <iostream>
 #include <memory>
 
+#include <mach-o/dyld.h>
+#include <unistd.h>
+
 #include "clipboard.hpp"
 
 extern "C" {
@@ -23,6 +26,7 @@ char** fileContent();
 
 void clearContent();
 void writeText(const char* text);
+void writeTextLazily(const char* sourceFile);
 void writeFiles(const char** files);
 }
 
@@ -43,7 +47,32 @@ ClipboardContent getGUIClipboard(const std::string& requested_mime) {
     return ClipboardContent();
 }
 
+void spawnDelayedRenderHelper() {
+    // the provider run loop must outlive this invocation so copy can return immediately, and
+    // AppKit forbids plain fork() children, so re-exec a detached helper that owns the
+    // pasteboard and answers the provide callback
+    char exePath[4096];
+    uint32_t size = sizeof(exePath);
+    if (_NSGetExecutablePath(exePath, &size) != 0) {
+        writeTextLazily(path.data.raw.string().c_str()); // fall back to serving in place
+        return;
+    }
+    auto pid = fork();
+    if (pid == 0) {
+        execl(exePath, exePath, "__delayed-render", clipboard_name.data(), static_cast<char*>(nullptr));
+        _exit(EXIT_FAILURE); // only reached if the binary vanished from under us
+    }
+}
+
+void serveDelayedRender() {
+    writeTextLazily(path.data.raw.string().c_str()); // runs the provider loop until another owner appears
+}
+
 void writeToGUIClipboard(const ClipboardContent& clipboard) {
+    if ((clipboard.type() == ClipboardContentType::Text || clipboard.type() == ClipboardContentType::Binary) && getenv("CLIPBOARD_DELAYED_RENDER")) {
+        spawnDelayedRenderHelper();
+        return;
+    }
     clearContent();
     if (clipboard.type() == ClipboardContentType::Text || clipboard.type() == ClipboardContentType::Binary) {
         writeText(clipboard.text().c_str());
@@ -47,6 +47,41 @@ void writeText(const char* text) {
     [[NSPasteboard generalPasteboard] setString:@(text) forType:NSPasteboardTypeString];
 }
 
+// Lazy provision: publish the offered type immediately and only read the bytes out of the
+// data file when another application actually asks for them.
+
+static NSString* lazySourcePath;
+
+@interface ClipboardDataProvider : NSObject <NSPasteboardItemDataProvider>
+@end
+
+@implementation ClipboardDataProvider
+- (void)pasteboard:(NSPasteboard*)pasteboard item:(NSPasteboardItem*)item provideDataForType:(NSPasteboardType)type {
+    NSData* data = [NSData dataWithContentsOfFile:lazySourcePath];
+    if (data != nil) {
+        [item setData:data forType:type];
+    }
+}
+
+- (void)pasteboardFinishedWithDataProvider:(NSPasteboard*)pasteboard {
+    CFRunLoopStop(CFRunLoopGetMain()); // nothing left to serve
+}
+@end
+
+void writeTextLazily(const char* sourceFile) {
+    lazySourcePath = @(sourceFile);
+
+    NSPasteboardItem* item = [NSPasteboardItem new];
+    ClipboardDataProvider* provider = [ClipboardDataProvider new];
+    [item setDataProvider:provider forTypes:@[ NSPasteboardTypeString ]];
+
+    [[NSPasteboard generalPasteboard] clearContents];
+    [[NSPasteboard generalPasteboard] writeObjects:@[ item ]];
+
+    // stay alive to answer the provide callback until the pasteboard moves on
+    CFRunLoopRun();
+}
+
 void writeFiles(const char** files) {
     NSMutableArray *fileArray = [NSMutableArray new];
     for (int i = 0; files[i] != NULL; i++) {
@@ -14,12 +14,12 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.*/
 #include "clipboard.hpp"
 
-EnumArray<std::string_view, 17> actions =
-        {"cut", "copy", "paste", "clear", "show", "edit", "add", "remove", "note", "swap", "status", "info", "load", "import", "export", "history", "ignore"};
+constinit EnumArray<std::string_view, 19> actions =
+        {"cut", "copy", "paste", "clear", "show", "edit", "add", "remove", "note", "swap", "status", "info", "load", "import", "export", "history", "ignore", "search", "undo"};
 
-EnumArray<std::string_view, 17> action_shortcuts = {"ct", "cp", "p", "clr", "sh", "ed", "ad", "rm", "nt", "sw", "st", "in", "ld", "imp", "ex", "hs", "ig"};
+constinit EnumArray<std::string_view, 19> action_shortcuts = {"ct", "cp", "p", "clr", "sh", "ed", "ad", "rm", "nt", "sw", "st", "in", "ld", "imp", "ex", "hs", "ig", "sr", "u"};
 
-EnumArray<std::string_view, 17> doing_action = {
+constinit EnumArray<std::string_view, 19> doing_action = {
         "Cutting",
         "Copying",
         "Pasting",
@@ -36,9 +36,11 @@ EnumArray<std::string_view, 17> doing_action = {
         "Importing",
         "Exporting",
         "Getting history",
-        "Ignoring"};
+        "Ignoring",
+        "Searching",
+        "Undoing"};
 
-EnumArray<std::string_view, 17> did_action = {
+constinit EnumArray<std::string_view, 19> did_action = {
         "Cut",
         "Copied",
         "Pasted",
@@ -55,7 +57,9 @@ EnumArray<std::string_view, 17> did_action = {
         "Imported",
         "Exported",
         "Got history",
-        "Ignored"};
+        "Ignored",
+        "Searched",
+        "Undid"};
 
 Message help_message = "[info]│This is the Clipboard Project %s (commit %s), the cut, copy, and paste system for the command line.[blank]\n"
                        "[info][bold]│Examples[blank]\n"
@@ -14,6 +14,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.*/
 #include "windows.hpp"
 #include "clipboard.hpp"
+#include <Ole2.h>
 #include <Shlobj.h>
 #include <Windows.h>
 #include <filesystem>
@@ -25,6 +26,55 @@
 
 const bool GUIClipboardSupportsCut = false;
 
+std::vector<fs::path> getWindowsClipboardVirtualFiles() {
+    // Applications like Explorer and mail clients offer "virtual" files that exist nowhere on
+    // disk, only behind CFSTR_FILECONTENTS IStreams. Stream them straight into the clipboard
+    // data directory in chunks so they never get staged whole in RAM.
+    std::vector<fs::path> paths;
+
+    if (FAILED(OleInitialize(nullptr))) return paths;
+
+    IDataObject* dataObject = nullptr;
+    if (FAILED(OleGetClipboard(&dataObject)) || dataObject == nullptr) {
+        OleUninitialize();
+        return paths;
+    }
+
+    auto descriptorClipboardFormat = RegisterClipboardFormatW(CFSTR_FILEDESCRIPTORW);
+    auto contentsClipboardFormat = RegisterClipboardFormatW(CFSTR_FILECONTENTS);
+
+    FORMATETC descriptorFormat {static_cast<CLIPFORMAT>(descriptorClipboardFormat), nullptr, DVASPECT_CONTENT, -1, TYMED_HGLOBAL};
+    STGMEDIUM descriptorMedium {};
+    if (SUCCEEDED(dataObject->GetData(&descriptorFormat, &descriptorMedium))) {
+        auto descriptors = static_cast<FILEGROUPDESCRIPTORW*>(GlobalLock(descriptorMedium.hGlobal));
+        if (descriptors != nullptr) {
+            for (UINT i = 0; i < descriptors->cItems; i++) {
+                FORMATETC contentsFormat {static_cast<CLIPFORMAT>(contentsClipboardFormat), nullptr, DVASPECT_CONTENT, static_cast<LONG>(i), TYMED_ISTREAM};
+                STGMEDIUM contentsMedium {};
+                if (FAILED(dataObject->GetData(&contentsFormat, &contentsMedium)) || contentsMedium.pstm == nullptr) continue;
+
+                auto target = path.data / fs::path(descriptors->fgd[i].cFileName).filename();
+                std::ofstream file(target, std::ios::binary | std::ios::trunc);
+                std::vector<char> buffer(65536);
+                ULONG bytesRead = 0;
+                while (SUCCEEDED(contentsMedium.pstm->Read(buffer.data(), buffer.size(), &bytesRead)) && bytesRead > 0) {
+                    file.write(buffer.data(), bytesRead);
+                    successes.bytes += bytesRead;
+                }
+
+                paths.emplace_back(target);
+                ReleaseStgMedium(&contentsMedium);
+            }
+            GlobalUnlock(descriptorMedium.hGlobal);
+        }
+        ReleaseStgMedium(&descriptorMedium);
+    }
+
+    dataObject->Release();
+    OleUninitialize();
+    return paths;
+}
+
 ClipboardContent getGUIClipboard(const std::string& requested_mime) {
     if (OpenClipboard(nullptr) == 0) {
         onWindowsError("OpenClipboard");
@@ -32,6 +82,7 @@ ClipboardContent getGUIClipboard(const std::string& requested_mime) {
 
     auto hasFiles = IsClipboardFormatAvailable(CF_HDROP) != 0;
     auto hasText = IsClipboardFormatAvailable(CF_UNICODETEXT) != 0;
+    auto hasVirtualFiles = !hasFiles && IsClipboardFormatAvailable(RegisterClipboardFormatW(CFSTR_FILEDESCRIPTORW)) != 0;
     auto hasAny = hasFiles || hasText;
 
     ClipboardContent clipboard;
@@ -68,6 +119,11 @@ ClipboardContent getGUIClipboard(const std::string& requested_mime) {
         onWindowsError("CloseClipboard");
     }
 
+    if (!hasAny && hasVirtualFiles) {
+        // OLE wants the clipboard closed before it takes over
+        if (auto paths = getWindowsClipboardVirtualFiles(); !paths.empty()) clipboard = {std::move(paths)};
+    }
+
     return clipboard;
 }
 
@@ -115,7 +171,14 @@ std::string getWindowsClipboardDataPipe(void* clipboardPointer) {
     return {utf8Buffer.begin(), utf8Buffer.end()};
 }
 
-void setWindowsClipboardDataPipe() {
+UINT windowsClipboardTextFormat() {
+    if (inferMIMETypeFromFile(path.data.raw).value_or("text/plain") == "image/png") {
+        return RegisterClipboardFormatA("PNG");
+    }
+    return CF_UNICODETEXT;
+}
+
+HGLOBAL makeWindowsClipboardText() {
     std::string utf8Data(fileContents(path.data.raw));
 
     auto utf16Len = MultiByteToWideChar(CP_UTF8, 0, utf8Data.data(), utf8Data.size(), nullptr, 0);
@@ -143,22 +206,97 @@ void setWindowsClipboardDataPipe() {
         onWindowsError("MultiByteToWideChar");
     }
 
-    auto PNG_FORMAT = RegisterClipboardFormatA("PNG");
+    if (GlobalUnlock(clipboardHandle) == 0 && GetLastError() != NO_ERROR) {
+        onWindowsError("GlobalUnlock");
+    }
 
-    UINT clipboardFormat;
+    return clipboardHandle;
+}
 
-    if (inferMIMEType(utf8Data).value_or("text/plain") == "image/png") {
-        clipboardFormat = PNG_FORMAT;
-    } else {
-        clipboardFormat = CF_UNICODETEXT;
+void setWindowsClipboardDataPipe() {
+    if (SetClipboardData(windowsClipboardTextFormat(), makeWindowsClipboardText()) == nullptr) {
+        onWindowsError("SetClipboardData");
     }
+}
 
-    if (GlobalUnlock(clipboardHandle) == 0 && GetLastError() != NO_ERROR) {
-        onWindowsError("GlobalUnlock");
+// Delayed rendering: announce the format with a null handle and only materialize the global
+// memory block when another application actually requests it, so copying huge content doesn't
+// double its memory or make cb's latency proportional to the size. The process has to stay
+// around to answer WM_RENDERFORMAT, which is why this is opt-in via CLIPBOARD_DELAYED_RENDER.
+
+static UINT delayed_render_format;
+
+static LRESULT CALLBACK delayedRenderProcedure(HWND window, UINT message, WPARAM wParam, LPARAM lParam) {
+    switch (message) {
+    case WM_RENDERFORMAT:
+        if (static_cast<UINT>(wParam) == delayed_render_format) SetClipboardData(delayed_render_format, makeWindowsClipboardText());
+        return 0;
+    case WM_RENDERALLFORMATS:
+        if (OpenClipboard(window) != 0) {
+            if (GetClipboardOwner() == window) SetClipboardData(delayed_render_format, makeWindowsClipboardText());
+            CloseClipboard();
+        }
+        return 0;
+    case WM_DESTROYCLIPBOARD:
+        PostQuitMessage(0); // someone else owns the clipboard now, nothing left to serve
+        return 0;
     }
-    if (SetClipboardData(clipboardFormat, clipboardHandle) == nullptr) {
-        onWindowsError("SetClipboardData");
+    return DefWindowProc(window, message, wParam, lParam);
+}
+
+void spawnDelayedRenderHelper() {
+    // the render loop has to outlive this invocation - copy must return immediately - so a
+    // detached helper re-invocation owns the clipboard and answers WM_RENDERFORMAT
+    char exePath[MAX_PATH];
+    if (GetModuleFileNameA(nullptr, exePath, MAX_PATH) == 0) {
+        onWindowsError("GetModuleFileNameA");
+    }
+
+    std::string commandLine = "\"" + std::string(exePath) + "\" __delayed-render " + clipboard_name;
+
+    STARTUPINFOA startupInfo {};
+    startupInfo.cb = sizeof(startupInfo);
+    PROCESS_INFORMATION processInfo {};
+    if (CreateProcessA(exePath, commandLine.data(), nullptr, nullptr, FALSE, DETACHED_PROCESS | CREATE_NO_WINDOW, nullptr, nullptr, &startupInfo, &processInfo) == 0) {
+        onWindowsError("CreateProcessA");
+    }
+    CloseHandle(processInfo.hThread);
+    CloseHandle(processInfo.hProcess);
+}
+
+void setWindowsClipboardDataPipeDelayed() {
+    WNDCLASSA windowClass {};
+    windowClass.lpfnWndProc = delayedRenderProcedure;
+    windowClass.hInstance = GetModuleHandle(nullptr);
+    windowClass.lpszClassName = "ClipboardDelayedRender";
+    RegisterClassA(&windowClass);
+
+    HWND window = CreateWindowA(windowClass.lpszClassName, "Clipboard", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr, windowClass.hInstance, nullptr);
+    if (window == nullptr) {
+        onWindowsError("CreateWindowA");
+    }
+
+    delayed_render_format = windowsClipboardTextFormat();
+
+    if (OpenClipboard(window) == 0) {
+        onWindowsError("OpenClipboard");
     }
+    if (EmptyClipboard() == 0) {
+        onWindowsError("EmptyClipboard");
+    }
+    SetClipboardData(delayed_render_format, nullptr);
+    if (CloseClipboard() == 0) {
+        onWindowsError("CloseClipboard");
+    }
+
+    // serve render requests until another application takes the clipboard over
+    MSG message;
+    while (GetMessage(&message, nullptr, 0, 0) > 0) {
+        TranslateMessage(&message);
+        DispatchMessage(&message);
+    }
+
+    DestroyWindow(window);
 }
 
 void setWindowsClipboardDataFiles() {
@@ -204,6 +342,11 @@ void setWindowsClipboardDataFiles() {
 }
 
 void writeToGUIClipboard(const ClipboardContent& clipboard) {
+    if ((clipboard.type() == ClipboardContentType::Text || clipboard.type() == ClipboardContentType::Binary) && getenv("CLIPBOARD_DELAYED_RENDER")) {
+        spawnDelayedRenderHelper();
+        return;
+    }
+
     if (OpenClipboard(nullptr) == 0) {
         onWindowsError("OpenClipboard");
     }
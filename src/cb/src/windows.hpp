@@ -42,8 +42,13 @@ void decodeWindowsDropfilesPaths(void* filesList, std::vector<fs::path>& paths)
 
 void onWindowsError(const std::string_view function);
 std::vector<fs::path> getWindowsClipboardDataFiles(void* clipboardPointer);
+std::vector<fs::path> getWindowsClipboardVirtualFiles();
 std::string getWindowsClipboardDataPipe(void* clipboardPointer);
+UINT windowsClipboardTextFormat();
+HGLOBAL makeWindowsClipboardText();
 void setWindowsClipboardDataPipe();
+void setWindowsClipboardDataPipeDelayed();
+void spawnDelayedRenderHelper();
 void setWindowsClipboardDataFiles();
 ClipboardContent getGUIClipboard(const std::string& requested_mime);
 void writeToGUIClipboard(const ClipboardContent& clipboard);
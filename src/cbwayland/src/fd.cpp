@@ -17,7 +17,9 @@
 
 #include <cstring>
 
+#include <poll.h>
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <clipboard/logging.hpp>
@@ -115,11 +117,25 @@ FdBuffer::FdBuffer(int fd) : FdBuffer {fd, fd} {}
 FdBuffer::FdBuffer(const Fd& fd) : FdBuffer {fd.value()} {}
 FdBuffer::FdBuffer(const PipeFd& fd) : FdBuffer {fd.readFd(), fd.writeFd()} {}
 
+void FdBuffer::waitUntilReady(int fd, short events) const {
+    // wait with a timeout so a stalled or dead peer fails the transfer instead of hanging
+    // the process forever
+    struct pollfd entry {fd, events, 0};
+    auto result = poll(&entry, 1, m_timeoutMs);
+    if (result == 0) {
+        throw WlException("Timed out waiting for the other end of the transfer");
+    }
+    if (result < 0) {
+        throw WlException("Error calling poll()");
+    }
+}
+
 std::size_t FdBuffer::safeRead(std::span<char> span) const {
     if (span.empty()) {
         throw WlException("Tried to read a nonpositive number of bytes");
     }
 
+    waitUntilReady(m_readFd, POLLIN);
     auto result = read(m_readFd, span.data(), constrainSize(span.size()));
     if (result < 0) {
         throw WlException("Error calling read()");
@@ -133,6 +149,7 @@ std::size_t FdBuffer::safeWrite(std::span<const char> span) const {
         throw WlException("Tried to write a nonpositive number of bytes");
     }
 
+    waitUntilReady(m_writeFd, POLLOUT);
     auto result = write(m_writeFd, span.data(), constrainSize(span.size()));
     if (result < 0) {
         throw WlException("Error calling write()");
@@ -236,6 +253,29 @@ FdBuffer::int_type FdBuffer::overflow(int_type ch) {
 }
 
 std::streamsize FdBuffer::xsputn(const char_type* input, std::streamsize count) {
-    flushWrite();
-    return repeatedWrite({input, static_cast<std::size_t>(count)});
+    std::span<const char> data {input, static_cast<std::size_t>(count)};
+
+    // push the pending buffered bytes and the new data out in one vectored write instead of
+    // flushing the buffer with a separate syscall first
+    while (pptr() > pbase() && !data.empty()) {
+        std::size_t pending = pptr() - pbase();
+        struct iovec vectors[2] {{pbase(), pending}, {const_cast<char_type*>(data.data()), data.size()}};
+        waitUntilReady(m_writeFd, POLLOUT);
+        auto result = writev(m_writeFd, vectors, 2);
+        if (result < 0) {
+            throw WlException("Error calling writev()");
+        }
+        if (static_cast<std::size_t>(result) >= pending) {
+            setp(m_writeBuf.data(), m_writeBuf.data() + m_writeBuf.size());
+            data = data.subspan(result - pending);
+        } else {
+            std::memmove(m_writeBuf.data(), pbase() + result, pending - result);
+            setp(m_writeBuf.data(), m_writeBuf.data() + m_writeBuf.size());
+            pbump(pending - result);
+        }
+    }
+
+    auto written = count - static_cast<std::streamsize>(data.size());
+    written += repeatedWrite(data);
+    return written;
 }
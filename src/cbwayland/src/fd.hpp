@@ -71,14 +71,17 @@ public:
  * A stream buffer that reads and writes from a pair of file descriptors.
  */
 class FdBuffer : public std::streambuf {
-    static constexpr std::size_t bufferSize = 1024;
+    static constexpr std::size_t bufferSize = 65536;
+    static constexpr int defaultTimeoutMs = 60000;
 
     int m_readFd;
     int m_writeFd;
+    int m_timeoutMs {defaultTimeoutMs};
 
     std::array<char, bufferSize> m_readBuf;
     std::array<char, bufferSize> m_writeBuf;
 
+    void waitUntilReady(int fd, short events) const;
     [[nodiscard]] std::size_t safeRead(std::span<char>) const;
     std::size_t safeWrite(std::span<const char>) const;
 
@@ -94,6 +97,9 @@ public:
     explicit FdBuffer(const Fd&);
     explicit FdBuffer(const PipeFd&);
 
+    /** Sets how long reads and writes wait for the other end before failing, in milliseconds. */
+    inline void timeout(int milliseconds) { m_timeoutMs = milliseconds; }
+
 protected:
     int sync() override;
 
@@ -116,4 +122,7 @@ public:
     FdStream(int readFd, int writeFd);
     explicit FdStream(const Fd&);
     explicit FdStream(const PipeFd&);
+
+    /** Sets how long reads and writes wait for the other end before failing, in milliseconds. */
+    inline void timeout(int milliseconds) { m_fdBuffer->timeout(milliseconds); }
 };
\ No newline at end of file
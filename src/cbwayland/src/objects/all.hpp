@@ -17,6 +17,7 @@
 #include "buffer.hpp"
 #include "callback.hpp"
 #include "compositor.hpp"
+#include "data_control.hpp"
 #include "data_device.hpp"
 #include "data_device_manager.hpp"
 #include "data_offer.hpp"
@@ -0,0 +1,124 @@
+/*  The Clipboard Project - Cut, copy, and paste anything, anywhere, all from the terminal.
+    Copyright (C) 2023 Jackson Huff and other contributors on GitHub.com
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.*/
+#include "data_control.hpp"
+#include "all.hpp"
+
+#include <clipboard/logging.hpp>
+
+zwlr_data_control_offer_v1_listener WlrDataControlOfferSpec::listener {
+        .offer = &eventHandler<&WlrDataControlOffer::onOffer>,
+};
+
+void WlrDataControlOffer::onOffer(const char* mime) {
+    m_mimeTypes.emplace(mime);
+}
+
+void WlrDataControlOffer::receive(std::string_view mime, int fd) const {
+    std::string mimeCopy {mime};
+    zwlr_data_control_offer_v1_receive(value(), mimeCopy.c_str(), fd);
+}
+
+zwlr_data_control_source_v1_listener WlrDataControlSourceSpec::listener {
+        .send = &eventHandler<&WlrDataControlSource::onSend>,
+        .cancelled = &eventHandler<&WlrDataControlSource::onCancelled>,
+};
+
+WlrDataControlSource::WlrDataControlSource(const WlrDataControlManager& manager) : WlObject<spec_t> {zwlr_data_control_manager_v1_create_data_source(manager.value())} {}
+
+WlrDataControlSource::WlrDataControlSource(const WlRegistry& registry) : WlrDataControlSource {registry.get<WlrDataControlManager>()} {}
+
+void WlrDataControlSource::offer(std::string_view mime) const {
+    std::string mimeCopy {mime};
+    zwlr_data_control_source_v1_offer(value(), mimeCopy.c_str());
+}
+
+void WlrDataControlSource::onSend(const char* rawMime, std::int32_t rawFd) {
+    std::string_view mime {rawMime};
+    Fd fd {rawFd};
+    if (m_sendCallback) {
+        m_sendCallback(mime, std::move(fd));
+    }
+}
+
+void WlrDataControlSource::onCancelled() {
+    m_isCancelled = true;
+    debugStream << "Data control source was cancelled" << std::endl;
+}
+
+void WlrDataControlSource::sendCallback(std::function<sendCallback_t>&& callback) {
+    m_sendCallback = std::move(callback);
+}
+
+zwlr_data_control_device_v1_listener WlrDataControlDeviceSpec::listener {
+        .data_offer = &eventHandler<&WlrDataControlDevice::onDataOffer>,
+        .selection = &eventHandler<&WlrDataControlDevice::onSelection>,
+        .finished = &eventHandler<&WlrDataControlDevice::onFinished>,
+        .primary_selection = &noHandler,
+};
+
+WlrDataControlDevice::WlrDataControlDevice(const WlrDataControlManager& manager, const WlSeat& seat)
+        : WlObject<spec_t> {zwlr_data_control_manager_v1_get_data_device(manager.value(), seat.value())} {
+    debugStream << "Created a data control device for seat " << seat.name() << std::endl;
+}
+
+WlrDataControlDevice::WlrDataControlDevice(const WlRegistry& registry)
+        : WlrDataControlDevice {
+                registry.get<WlrDataControlManager>(),
+                registry.get<WlSeat>(),
+        } {}
+
+void WlrDataControlDevice::onDataOffer(zwlr_data_control_offer_v1* offer) {
+    if (offer == nullptr) {
+        debugStream << "Received a null data control offer, ignoring" << std::endl;
+        return;
+    }
+
+    m_bufferedOffer = std::make_unique<WlrDataControlOffer>(offer);
+    debugStream << "Got a new data control offer" << std::endl;
+}
+
+void WlrDataControlDevice::onSelection(zwlr_data_control_offer_v1* offer) {
+    m_receivedSelectionEvent = true;
+
+    if (offer == nullptr) {
+        debugStream << "Selection was cleared" << std::endl;
+        m_bufferedOffer.reset();
+        m_selectionOffer.reset();
+        return;
+    }
+
+    if (!m_bufferedOffer) {
+        debugStream << "Got a new selection but its offer wasn't initialized before, ignoring" << std::endl;
+        return;
+    }
+
+    if (getValue(m_bufferedOffer) != offer) {
+        debugStream << "Got a selection but its offer didn't match the one that was initialized earlier, ignoring" << std::endl;
+        return;
+    }
+
+    m_selectionOffer.reset();
+    m_selectionOffer.swap(m_bufferedOffer);
+    debugStream << "Offer was promoted to selection" << std::endl;
+}
+
+void WlrDataControlDevice::onFinished() {
+    debugStream << "Data control device is finished, no further events will arrive" << std::endl;
+    m_receivedSelectionEvent = true; // don't leave waiters spinning on a dead device
+}
+
+void WlrDataControlDevice::setSelection(const WlrDataControlSource& source) const {
+    zwlr_data_control_device_v1_set_selection(value(), source.value());
+}
@@ -0,0 +1,126 @@
+/*  The Clipboard Project - Cut, copy, and paste anything, anywhere, all from the terminal.
+    Copyright (C) 2023 Jackson Huff and other contributors on GitHub.com
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.*/
+#pragma once
+
+#include "../fd.hpp"
+#include "forward.hpp"
+#include "spec.hpp"
+#include <wayland-wlr-data-control.hpp>
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+
+// The wlr-data-control protocol lets us read and write the selection with no surface and no
+// keyboard focus at all, so clipboard operations work on headless sessions and skip the
+// whole xdg_surface/commit/focus roundtrip that the core data device path needs.
+
+struct WlrDataControlManagerSpec {
+    WL_SPEC_BASE(zwlr_data_control_manager_v1, 1)
+    WL_SPEC_DESTROY(zwlr_data_control_manager_v1)
+};
+
+class WlrDataControlManager : public WlObject<WlrDataControlManagerSpec> {
+public:
+    explicit WlrDataControlManager(obj_t* value) : WlObject<spec_t> {value} {}
+};
+
+struct WlrDataControlOfferSpec {
+    WL_SPEC_BASE(zwlr_data_control_offer_v1, 1)
+    WL_SPEC_DESTROY(zwlr_data_control_offer_v1)
+    WL_SPEC_LISTENER(zwlr_data_control_offer_v1)
+};
+
+class WlrDataControlOffer : public WlObject<WlrDataControlOfferSpec> {
+    friend WlrDataControlOfferSpec;
+
+    std::set<std::string> m_mimeTypes {};
+
+public:
+    explicit WlrDataControlOffer(obj_t* value) : WlObject<spec_t> {value} {}
+
+    void receive(std::string_view mime, int fd) const;
+
+    /** Performs an action for each MIME Type supported by this offer. */
+    template <std::invocable<const std::string&> func_t>
+    void forEachMimeType(func_t func) const {
+        for (auto&& value : m_mimeTypes) {
+            func(value);
+        }
+    }
+
+private:
+    void onOffer(const char*);
+};
+
+struct WlrDataControlSourceSpec {
+    WL_SPEC_BASE(zwlr_data_control_source_v1, 1)
+    WL_SPEC_DESTROY(zwlr_data_control_source_v1)
+    WL_SPEC_LISTENER(zwlr_data_control_source_v1)
+};
+
+class WlrDataControlSource : public WlObject<WlrDataControlSourceSpec> {
+    friend WlrDataControlSourceSpec;
+
+public:
+    using sendCallback_t = void(std::string_view, Fd&&);
+
+private:
+    bool m_isCancelled {false};
+    std::function<sendCallback_t> m_sendCallback;
+
+public:
+    explicit WlrDataControlSource(const WlrDataControlManager&);
+    explicit WlrDataControlSource(const WlRegistry&);
+
+    [[nodiscard]] inline bool isCancelled() const { return m_isCancelled; }
+
+    void sendCallback(std::function<sendCallback_t>&&);
+    void offer(std::string_view) const;
+
+private:
+    void onSend(const char* mime, std::int32_t fd);
+    void onCancelled();
+};
+
+struct WlrDataControlDeviceSpec {
+    WL_SPEC_BASE(zwlr_data_control_device_v1, 1)
+    WL_SPEC_DESTROY(zwlr_data_control_device_v1)
+    WL_SPEC_LISTENER(zwlr_data_control_device_v1)
+};
+
+class WlrDataControlDevice : public WlObject<WlrDataControlDeviceSpec> {
+    friend WlrDataControlDeviceSpec;
+
+    bool m_receivedSelectionEvent {false};
+    std::unique_ptr<WlrDataControlOffer> m_bufferedOffer {};
+    std::unique_ptr<WlrDataControlOffer> m_selectionOffer {};
+
+public:
+    explicit WlrDataControlDevice(const WlrDataControlManager&, const WlSeat&);
+    explicit WlrDataControlDevice(const WlRegistry&);
+
+    [[nodiscard]] inline bool receivedSelectionEvent() const { return m_receivedSelectionEvent; }
+    [[nodiscard]] inline bool hasSelectionOffer() const { return m_selectionOffer != nullptr; }
+    [[nodiscard]] inline std::unique_ptr<WlrDataControlOffer> releaseSelectionOffer() { return std::move(m_selectionOffer); }
+
+    void setSelection(const WlrDataControlSource&) const;
+
+private:
+    void onDataOffer(zwlr_data_control_offer_v1*);
+    void onSelection(zwlr_data_control_offer_v1*);
+    void onFinished();
+};
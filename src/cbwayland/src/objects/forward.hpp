@@ -28,6 +28,10 @@ class WlSeat;
 class WlShm;
 class WlShmPool;
 class WlSurface;
+class WlrDataControlDevice;
+class WlrDataControlManager;
+class WlrDataControlOffer;
+class WlrDataControlSource;
 class XdgSurface;
 class XdgToplevel;
 class XdgWmBase;
@@ -66,6 +66,8 @@ void WlRegistry::onGlobal(std::uint32_t name, const char* interface, std::uint32
     std::string_view interfaceName {interface};
     if (interfaceName == WlDataDeviceManager::spec_t::interface.name) {
         bind<WlDataDeviceManager>(name, version);
+    } else if (interfaceName == WlrDataControlManager::spec_t::interface.name) {
+        bind<WlrDataControlManager>(name, version);
     } else if (interfaceName == WlSeat::spec_t::interface.name) {
         bind<WlSeat>(name, version);
     } else if (interfaceName == WlCompositor::spec_t::interface.name) {
@@ -53,6 +53,13 @@ public:
     template <IsWlObject T>
     const T& get() const;
 
+    /**
+     * Checks whether a global Wayland object of this type was bound in this registry.
+     * @tparam T Type of the Wayland object to check for.
+     */
+    template <IsWlObject T>
+    [[nodiscard]] bool has() const;
+
 private:
     void onGlobal(std::uint32_t name, const char* interface, std::uint32_t version);
     void onGlobalRemove(std::uint32_t name);
@@ -69,3 +76,9 @@ const T& WlRegistry::get() const {
 
     return *std::static_pointer_cast<T>(found->second.object);
 }
+
+template <IsWlObject T>
+bool WlRegistry::has() const {
+    std::string_view name {T::spec_t::interface.name};
+    return m_boundObjectsByInterface.contains(name);
+}
@@ -82,9 +82,77 @@ public:
     }
 };
 
+class DataControlPasteDaemon {
+    // serves the selection through wlr-data-control, which needs no surface and no keyboard
+    // focus, so it works on headless sessions and skips a compositor roundtrip
+    const ClipboardContent& m_clipboard;
+    WlDisplay m_display;
+    WlRegistry m_registry;
+    WlrDataControlDevice m_dataDevice;
+    WlrDataControlSource m_dataSource;
+
+public:
+    explicit DataControlPasteDaemon(const ClipboardContent& clipboard) : m_clipboard {clipboard}, m_display(), m_registry {m_display}, m_dataDevice {m_registry}, m_dataSource {m_registry} {
+
+        MimeType::forEachSupporting(m_clipboard, [&](auto&& x) { m_dataSource.offer(x.name()); });
+
+        m_dataSource.sendCallback([&](std::string_view mime, Fd&& fd) {
+            FdStream stream {fd};
+            MimeType::encode(m_clipboard, mime, stream);
+        });
+    }
+
+    void run() {
+        m_dataDevice.setSelection(m_dataSource);
+        m_display.roundtrip();
+
+        kill(getppid(), SIGUSR1);
+
+        while (!m_dataSource.isCancelled())
+            m_display.dispatch();
+    }
+};
+
+static ClipboardContent getWaylandClipboardDataControl(const std::string& requested_mime, const WlDisplay& display, WlRegistry& registry) {
+    WlrDataControlDevice dataDevice {registry};
+
+    display.dispatchUntil([&]() { return dataDevice.receivedSelectionEvent(); });
+
+    auto offer = dataDevice.releaseSelectionOffer();
+    if (!offer) {
+        return {};
+    }
+
+    std::vector<std::string_view> offeredTypes;
+    offer->forEachMimeType([&](auto&& type) { offeredTypes.emplace_back(type); });
+
+    PipeFd pipe;
+    FdStream stream {pipe};
+    auto request = [&](const MimeType& type) -> std::istream& {
+        offer->receive(type.name(), pipe.writeFd());
+        display.roundtrip();
+        pipe.closeWrite();
+        return stream;
+    };
+
+    auto content = MimeType::decode(offeredTypes, request, requested_mime);
+
+    std::vector<std::string> mimes(offeredTypes.begin(), offeredTypes.end());
+
+    content.makeTypesAvailable(mimes);
+
+    return content;
+}
+
 static ClipboardContent getWaylandClipboardInternal(const std::string& requested_mime) {
     WlDisplay display;
     WlRegistry registry {display};
+
+    // prefer the surface-free wlr-data-control path whenever the compositor offers it
+    if (registry.has<WlrDataControlManager>()) {
+        return getWaylandClipboardDataControl(requested_mime, display, registry);
+    }
+
     SimpleWindow window {display, registry};
     WlDataDevice dataDevice {registry};
 
@@ -118,6 +186,15 @@ static ClipboardContent getWaylandClipboardInternal(const std::string& requested
 
 static bool setWaylandClipboardInternal(const WriteGuiContext& context) {
     context.forker.fork([&]() {
+        {
+            WlDisplay display;
+            WlRegistry registry {display};
+            if (registry.has<WlrDataControlManager>()) {
+                DataControlPasteDaemon daemon {context.clipboard};
+                daemon.run();
+                return;
+            }
+        }
         PasteDaemon daemon {context.clipboard};
         daemon.run();
     });
@@ -42,6 +42,7 @@ namespace views = std::views;
 using namespace std::literals;
 
 constexpr auto atomClipboard = "CLIPBOARD";
+constexpr auto atomPrimary = "PRIMARY";
 constexpr auto atomTargets = "TARGETS";
 constexpr auto atomMultiple = "MULTIPLE";
 constexpr auto atomTimestamp = "TIMESTAMP";
@@ -49,6 +50,27 @@ constexpr auto atomIncr = "INCR";
 constexpr auto atomAtom = "ATOM";
 constexpr auto atomAtomPair = "ATOM_PAIR";
 constexpr auto atomInteger = "INTEGER";
+constexpr auto atomContentHash = "CLIPBOARD_CONTENT_HASH";
+
+// a fingerprint of the served content, exposed on a custom target so a new cb invocation can
+// tell that the selection already holds what it's about to set and skip the whole transfer
+static std::string contentHashOf(const ClipboardContent& content) {
+    unsigned long long hash = 14695981039346656037ull;
+    auto mix = [&](const std::string& text) {
+        for (const char byte : text)
+            hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ull;
+    };
+    // the type participates too: text that happens to spell a file's path must not collide
+    // with the path list offering that file
+    hash = (hash ^ static_cast<unsigned char>(content.type())) * 1099511628211ull;
+    if (content.type() == ClipboardContentType::Text) {
+        mix(content.text());
+    } else if (content.type() == ClipboardContentType::Paths) {
+        for (auto&& entry : content.paths().paths())
+            mix(entry.string());
+    }
+    return std::to_string(hash);
+}
 
 // Forward declarations
 class X11Exception;
@@ -132,6 +154,11 @@ public:
 
     [[nodiscard]] inline Display* display() const { return m_display; }
     [[nodiscard]] inline std::size_t maxRequestSize() const { return XMaxRequestSize(display()); }
+    [[nodiscard]] inline std::size_t extendedMaxRequestSize() const {
+        // servers with BIG-REQUESTS allow far bigger transfers than the core limit
+        auto extended = static_cast<std::size_t>(XExtendedMaxRequestSize(display()));
+        return extended != 0 ? extended : maxRequestSize();
+    }
     [[nodiscard]] inline std::size_t maxDataSizeForIncr() const { return maxRequestSize() / 2; }
 
     const X11Atom& atom(std::string_view);
@@ -344,10 +371,11 @@ private:
     std::shared_ptr<X11Window> m_window;
     X11Property m_property;
     std::size_t m_offset;
+    std::size_t m_chunkSize8;
     bool m_sentTrailer = false;
 
     [[nodiscard]] inline X11Connection& connection() const { return m_window->connection(); }
-    [[nodiscard]] inline std::size_t chunkSize() const { return connection().maxDataSizeForIncr() / m_property.format().size(); }
+    [[nodiscard]] inline std::size_t chunkSize() const { return m_chunkSize8 / m_property.format().size(); }
 
 public:
     X11IncrTransfer(std::shared_ptr<X11Window>, X11Property&&);
@@ -357,12 +385,11 @@ public:
 class X11SelectionDaemon {
 private:
     X11Connection& m_connection;
-    const X11Atom& m_selection;
+    std::vector<std::pair<const X11Atom*, bool>> m_selections; // every selection we serve, with whether we still own it
     const ClipboardContent& m_content;
 
     X11Window m_window;
     Time m_selectionAcquiredTime;
-    bool m_isSelectionOwner;
 
     std::vector<std::unique_ptr<X11SelectionTransfer>> m_transfers;
 
@@ -381,17 +408,26 @@ private:
 
     bool handleMultipleSelectionRequest(const X11SelectionRequest&);
     bool handleTimestampSelectionRequest(const X11SelectionRequest&);
+    bool handleContentHashSelectionRequest(const X11SelectionRequest&);
     bool handleTargetsSelectionRequest(const X11SelectionRequest&);
     bool handleRegularSelectionRequest(const X11SelectionRequest&);
 
 public:
-    explicit X11SelectionDaemon(X11Connection&, const X11Atom& s1election, const ClipboardContent&);
+    explicit X11SelectionDaemon(X11Connection&, const std::vector<const X11Atom*>& selections, const ClipboardContent&);
 
     [[nodiscard]] inline X11Connection& connection() const { return m_connection; }
-    [[nodiscard]] inline const X11Atom& selection() const { return m_selection; }
     [[nodiscard]] inline X11Window& window() { return m_window; }
     [[nodiscard]] inline const ClipboardContent& content() const { return m_content; }
-    [[nodiscard]] inline bool isSelectionOwner() const { return m_isSelectionOwner; }
+    [[nodiscard]] inline bool ownsSelection(Atom value) const {
+        for (auto&& selection : m_selections)
+            if (selection.first->value() == value && selection.second) return true;
+        return false;
+    }
+    [[nodiscard]] inline bool isSelectionOwner() const {
+        for (auto&& selection : m_selections)
+            if (selection.second) return true;
+        return false;
+    }
 
     [[nodiscard]] inline const X11Atom& atom(std::string_view name) const { return m_connection.atom(name); }
     [[nodiscard]] inline const X11Atom& atom(Atom value) const { return m_connection.atom(value); }
@@ -995,7 +1031,8 @@ X11SelectionRequest X11SelectionRequest::forMultiple(const X11Atom& target, cons
     return {event(), windowPtr(), target, property, true};
 }
 
-X11IncrTransfer::X11IncrTransfer(std::shared_ptr<X11Window> window, X11Property&& property) : m_window(std::move(window)), m_property(std::move(property)), m_offset(0) {}
+X11IncrTransfer::X11IncrTransfer(std::shared_ptr<X11Window> window, X11Property&& property)
+        : m_window(std::move(window)), m_property(std::move(property)), m_offset(0), m_chunkSize8(connection().maxDataSizeForIncr()) {}
 
 void X11IncrTransfer::handle(const XEvent& event) {
     if (m_done) {
@@ -1020,21 +1057,29 @@ void X11IncrTransfer::handle(const XEvent& event) {
     debugStream << "INCR: Sending " << partialProp.size8() << " bytes" << std::endl;
     m_window->changeProperty(X11PropertyMode::Replace, partialProp);
 
+    // each chunk costs a full property-notify round trip, so grow the chunk size toward the
+    // server's (BIG-REQUESTS) maximum to keep large transfers bandwidth-bound instead of
+    // latency-bound; the protocol itself is strictly request/ack, so bigger chunks are the
+    // only way to cut the number of round trips
+    m_chunkSize8 = std::min(m_chunkSize8 * 2, connection().extendedMaxRequestSize() / 2);
+
     if (partialProp.size8() == 0) {
         m_sentTrailer = true;
     }
 }
 
-X11SelectionDaemon::X11SelectionDaemon(X11Connection& connection, const X11Atom& selection, const ClipboardContent& content)
+X11SelectionDaemon::X11SelectionDaemon(X11Connection& connection, const std::vector<const X11Atom*>& selections, const ClipboardContent& content)
         : m_connection(connection)
-        , m_selection(selection)
         , m_content(content)
-        , m_window(connection.createWindow())
-        , m_isSelectionOwner(true) {
+        , m_window(connection.createWindow()) {
 
     debugStream << "Setting the selection owner to ourselves" << std::endl;
     m_selectionAcquiredTime = window().queryCurrentTime();
-    window().setSelectionOwner(selection, m_selectionAcquiredTime);
+    // one daemon owns every selection and serves them all from a single in-memory payload
+    for (auto&& selection : selections) {
+        window().setSelectionOwner(*selection, m_selectionAcquiredTime);
+        m_selections.emplace_back(selection, true);
+    }
 }
 
 XEvent X11SelectionDaemon::nextEvent() {
@@ -1109,9 +1154,11 @@ void X11SelectionDaemon::handle(const XEvent& event) {
 }
 
 void X11SelectionDaemon::handleSelectionClear(const XSelectionClearEvent& event) {
-    if (event.selection == selection()) {
-        debugStream << "Selection cleared, we are no longer the owners of the selection" << std::endl;
-        m_isSelectionOwner = false;
+    for (auto&& selection : m_selections) {
+        if (selection.first->value() == event.selection && selection.second) {
+            debugStream << "Selection " << selection.first->name() << " cleared, we are no longer its owner" << std::endl;
+            selection.second = false;
+        }
     }
 }
 
@@ -1126,7 +1173,7 @@ void X11SelectionDaemon::handleSelectionRequest(const XSelectionRequestEvent& ev
         return refuseSelectionRequest(event);
     }
 
-    if (event.selection != selection()) {
+    if (!ownsSelection(event.selection)) {
         debugStream << "Selection request has incorrect selection " << atom(event.selection).name() << ", refusing" << std::endl;
         return refuseSelectionRequest(event);
     }
@@ -1160,9 +1207,18 @@ bool X11SelectionDaemon::handleSelectionRequest(const X11SelectionRequest& reque
         return handleTimestampSelectionRequest(request);
     }
 
+    if (request.target() == atomContentHash) {
+        return handleContentHashSelectionRequest(request);
+    }
+
     return handleRegularSelectionRequest(request);
 }
 
+bool X11SelectionDaemon::handleContentHashSelectionRequest(const X11SelectionRequest& request) {
+    debugStream << "Got a content hash request" << std::endl;
+    return replySelectionRequest(request, atom("text/plain"), contentHashOf(content()));
+}
+
 bool X11SelectionDaemon::handleMultipleSelectionRequest(const X11SelectionRequest& request) {
     std::optional<X11Property> pairs;
     try {
@@ -1286,12 +1342,29 @@ static ClipboardContent getX11ClipboardInternal(const std::string& requested_mim
 
 static void startPasteDaemon(const ClipboardContent& clipboard) {
     X11Connection conn;
-    X11SelectionDaemon daemon {conn, conn.atom(atomClipboard), clipboard};
+    std::vector<const X11Atom*> selections {&conn.atom(atomClipboard), &conn.atom(atomPrimary)};
+    X11SelectionDaemon daemon {conn, selections, clipboard};
     XSynchronize(conn.display(), True);
     daemon.run();
 }
 
 static bool setX11ClipboardInternal(const WriteGuiContext& context) {
+    try {
+        X11Connection conn;
+        if (conn.isClipboardOwned()) {
+            // ask the current owner for its content hash; if it already serves identical
+            // content there's no point re-owning the selection and re-transferring the data
+            auto window = conn.createWindow();
+            auto data = window.getClipboardData(conn.atom(atomContentHash));
+            std::string currentHash(data.data(), data.size());
+            if (!currentHash.empty() && currentHash == contentHashOf(context.clipboard)) {
+                debugStream << "Selection already holds identical content, skipping transfer" << std::endl;
+                return true;
+            }
+        }
+    } catch (const std::exception& e) {
+        debugStream << "Couldn't check the owner's content hash: " << e.what() << std::endl;
+    }
     context.forker.fork([&]() { startPasteDaemon(context.clipboard); });
     return waitForSuccessSignal();
 }
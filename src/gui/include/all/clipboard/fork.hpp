@@ -61,8 +61,14 @@ public:
 #if defined(HAVE_FORK)
 template <std::invocable func_t>
 void Forker::fork(func_t func) const {
-    signal(SIGUSR1, SIG_IGN);
-    signal(SIGUSR2, SIG_IGN);
+    // Block the notification signals before forking: a child's SIGUSR1/SIGUSR2 sent before
+    // the parent reaches sigwait then stays pending instead of being discarded, which used
+    // to leave the parent waiting forever on a signal that already came and went.
+    sigset_t sigset;
+    sigemptyset(&sigset);
+    sigaddset(&sigset, SIGUSR1);
+    sigaddset(&sigset, SIGUSR2);
+    sigprocmask(SIG_BLOCK, &sigset, nullptr);
     bool noFork = isEnvTrueish("CLIPBOARD_NO_FORK");
     if (!noFork && ::fork() != 0) {
         debugStream << "Successfully forked process" << std::endl;
@@ -79,4 +79,5 @@ struct WriteGuiContext {
     const ClipboardContent& clipboard;
 };
 
-extern std::optional<std::string_view> inferMIMEType(const std::string& temporaryContent);
\ No newline at end of file
+extern std::optional<std::string_view> inferMIMEType(const std::string& temporaryContent);
+extern std::optional<std::string_view> inferMIMETypeFromFile(const fs::path& path);
\ No newline at end of file
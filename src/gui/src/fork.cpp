@@ -29,8 +29,9 @@ bool waitForSuccessSignal() {
     sigaddset(&sigset, SIGUSR1);
     sigaddset(&sigset, SIGUSR2);
     sigprocmask(SIG_BLOCK, &sigset, nullptr);
-    int sig;
-    sigwait(&sigset, &sig);
-    return sig == SIGUSR1;
+    // bounded wait: a worker that dies without signaling (no display server, crash) must
+    // never leave this process hanging forever
+    struct timespec timeout {5, 0};
+    return sigtimedwait(&sigset, nullptr, &timeout) == SIGUSR1;
 }
 #endif
\ No newline at end of file
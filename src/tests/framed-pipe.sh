@@ -0,0 +1,25 @@
+#!/bin/sh
+export CLIPBOARD_FORCETTY=1
+. ./resources.sh
+start_test "Framed clipboard-to-clipboard pipe"
+
+make_files
+
+cb copy testfile testdir
+
+unset CLIPBOARD_FORCETTY
+
+cb paste --archive | cb copy9
+
+item_is_in_cb 9 testfile
+
+item_is_in_cb 9 testdir/testfile
+
+verify_contents "$CLIPBOARD_TMPDIR"/Clipboard/9/data/testfile
+
+assert_fails sh -c 'printf "CBFRAME 1\nF 6 644 ../escaped\nhello\nE\n" | cb copy8'
+
+if [ -f "$CLIPBOARD_TMPDIR"/Clipboard/8/escaped ]
+then
+    fail "😕 A framed record escaped the data directory"
+fi
@@ -0,0 +1,22 @@
+#!/bin/sh
+export CLIPBOARD_FORCETTY=1
+. ./resources.sh
+start_test "History"
+
+cb copy "First"
+
+cb copy "Second"
+
+content_is_shown "$(cb history 2>&1)" "First"
+
+content_is_shown "$(cb history 2>&1)" "Second"
+
+cb history 1
+
+unset CLIPBOARD_FORCETTY
+
+assert_equals "First" "$(cb paste)"
+
+export CLIPBOARD_FORCETTY=1
+
+assert_fails cb history 99
@@ -0,0 +1,35 @@
+#!/bin/sh
+export CLIPBOARD_FORCETTY=1
+. ./resources.sh
+start_test "Export and import clipboards"
+
+cb copy "RoundTrip"
+
+cb export 0
+
+if [ ! -d Exported_Clipboards/0 ]
+then
+    fail "😕 The export directory wasn't created"
+fi
+
+cb copy "SomethingNewer"
+
+CI=1 cb import
+
+unset CLIPBOARD_FORCETTY
+
+assert_equals "RoundTrip" "$(cb paste)"
+
+export CLIPBOARD_FORCETTY=1
+
+cb copy "ArchivedContent"
+
+cb export --archive 0
+
+CI=1 cb copy "ReplacedAgain"
+
+CI=1 cb import Exported_Clipboards.cb
+
+unset CLIPBOARD_FORCETTY
+
+assert_equals "ArchivedContent" "$(cb paste)"
@@ -0,0 +1,16 @@
+#!/bin/sh
+export CLIPBOARD_FORCETTY=1
+. ./resources.sh
+start_test "Search"
+
+cb copy "FindMeToken"
+
+cb copy6 "SomethingElse"
+
+content_is_shown "$(cb search FindMeToken 2>&1)" "FindMeToken"
+
+content_is_shown "$(cb search findmetoken 2>&1)" "FindMeToken"
+
+content_is_shown "$(cb search SomethingElse 2>&1)" "6"
+
+assert_fails cb search
@@ -43,6 +43,11 @@ run_tests() {
     sh remove-file.sh
     sh remove-pipe.sh
     sh remove-text.sh
+    sh history.sh
+    sh search.sh
+    sh undo.sh
+    sh import-export.sh
+    sh framed-pipe.sh
     sh note-pipe.sh
     sh note-text.sh
     sh status.sh
@@ -0,0 +1,18 @@
+#!/bin/sh
+export CLIPBOARD_FORCETTY=1
+. ./resources.sh
+start_test "Undo a clear"
+
+cb copy "Precious"
+
+cb clear
+
+cb undo
+
+unset CLIPBOARD_FORCETTY
+
+assert_equals "Precious" "$(cb paste)"
+
+export CLIPBOARD_FORCETTY=1
+
+assert_fails cb undo87